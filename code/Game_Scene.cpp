@@ -10,9 +10,12 @@
 
 #include "Game_Scene.hpp"
 
+#include <algorithm>
 #include <cstdlib>
+#include <basics/Asset_Reader>
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Texture_Manager>
 
 using namespace basics;
 using namespace std;
@@ -66,6 +69,7 @@ namespace example
     constexpr float Game_Scene::  truck_speed;
     constexpr float Game_Scene::  ball_speed;
     constexpr float Game_Scene::player_speed;
+    constexpr unsigned Game_Scene::parallel_obstacle_count;
 
     // ---------------------------------------------------------------------------------------------
 
@@ -82,6 +86,11 @@ namespace example
 
         srand (unsigned(time(nullptr)));
 
+        // Los toques que llegan mientras se actualiza la escena se usan para resaltar las flechas
+        // antes de dibujar:
+
+        enable_late_latch (true);
+
         // Se inicializan otros atributos:
 
         initialize ();
@@ -98,6 +107,12 @@ namespace example
         suspended = true;
         gameplay  = UNINITIALIZED;
 
+        touch_pointer_id = -1;
+        touch_predictor.clear ();
+
+        obstacle_count = 0;
+        restarted      = false;
+
         return true;
     }
 
@@ -121,6 +136,8 @@ namespace example
     {
         if (state == RUNNING)               // Se descartan los eventos cuando la escena está LOADING
         {
+            touch_predictor.handle (event);
+
             if (gameplay == WAITING_TO_START)
             {
 
@@ -130,11 +147,12 @@ namespace example
             {
                 case ID(touch-started):     // El usuario toca la pantalla
                 {
-                    touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
+                    touch_location   = { event.touch.x, event.touch.y };
+                    touch_pointer_id = event.touch.pointer_id;
 
 
-                    user_target_x = *event[ID(x)].as< var::Float > ();
-                    user_target_y = *event[ID(y)].as< var::Float > ();
+                    user_target_x = event.touch.x;
+                    user_target_y = event.touch.y;
 
 
                     follow_target = true;
@@ -144,6 +162,10 @@ namespace example
                 case ID(touch-moved):
 
                 {
+                    if (event.touch.pointer_id == touch_pointer_id)
+                    {
+                        touch_location = { event.touch.x, event.touch.y };
+                    }
 
                     break;
                 }
@@ -160,6 +182,32 @@ namespace example
 
     // ---------------------------------------------------------------------------------------------
 
+    void Game_Scene::latch (const Event & event)
+    {
+        if (state == RUNNING && gameplay != WAITING_TO_START)
+        {
+            // Solo se cambia el aspecto de las flechas. La simulación recibirá estos mismos eventos
+            // en handle() en el siguiente fotograma:
+
+            if (event.id == ID(touch-started))
+            {
+                highlight_arrows (true, { event.touch.x, event.touch.y });
+            }
+            else
+            if (event.id == ID(touch-moved) && event.touch.pointer_id == touch_pointer_id)
+            {
+                highlight_arrows (follow_target, { event.touch.x, event.touch.y });
+            }
+            else
+            if (event.id == ID(touch-ended))
+            {
+                highlight_arrows (false, touch_location);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Game_Scene::update (float time)
     {
         if (!suspended) switch (state)
@@ -203,6 +251,22 @@ namespace example
         }
     }
 
+    // ---------------------------------------------------------------------------------------------
+
+    bool Game_Scene::capture (basics::Render_Snapshot & snapshot)
+    {
+        if (suspended || state != RUNNING) return false;
+
+        snapshot.canvas_size = { canvas_width, canvas_height };
+
+        for (auto & sprite : sprites)
+        {
+            sprite->capture (snapshot);
+        }
+
+        return true;
+    }
+
     // ---------------------------------------------------------------------------------------------
     // En este método solo se carga una textura por fotograma para poder pausar la carga si el
     // juego pasa a segundo plano inesperadamente. Otro aspecto interesante es que la carga no
@@ -214,6 +278,38 @@ namespace example
     {
         if (textures.size () < textures_count)          // Si quedan texturas por cargar...
         {
+            // Se descartan los bordes transparentes de las imágenes para no rasterizar pixels
+            // que no se ven. Las colisiones siguen usando el tamaño original:
+
+            Texture_2D::Options options = {};
+
+            options.trim      = true;
+
+            // Tras subirlas solo se conserva una copia comprimida con LZ4 (unos 217 KB en lugar
+            // de 2 MB) para poder restaurarlas si se pierde el contexto gráfico:
+
+            options.retention = Texture_2D::RETAIN_COMPRESSED;
+
+            Texture_Manager & texture_manager = director.get_texture_manager ();
+
+            // Al empezar se piden al hilo de entrada/salida los archivos de las texturas que el
+            // gestor no tiene ya cargadas para que se lean mientras se decodifican las anteriores:
+
+            if (textures.empty ())
+            {
+                std::vector< std::string > paths;
+
+                for (unsigned index = 0; index < textures_count; ++index)
+                {
+                    if (!texture_manager.contains (textures_data[index].path, options))
+                    {
+                        paths.push_back (textures_data[index].path);
+                    }
+                }
+
+                if (!paths.empty ()) Asset_Reader::prefetch (paths);
+            }
+
             // Las texturas se cargan y se suben al contexto gráfico, por lo que es necesario disponer
             // de uno:
 
@@ -224,11 +320,18 @@ namespace example
                 // Se carga la siguiente textura (textures.size() indica cuántas llevamos cargadas):
 
                 Texture_Data   & texture_data = textures_data[textures.size ()];
-                Texture_Handle & texture      = textures[texture_data.id] = Texture_2D::create (texture_data.id, context, texture_data.path);
+                Texture_Handle & texture      = textures[texture_data.id] = texture_manager.acquire
+                (
+                    texture_data.id, context, texture_data.path, options
+                );
 
-                // Se comprueba si la textura se ha podido cargar correctamente:
+                // Se comprueba si la textura se ha podido cargar correctamente. Las texturas se
+                // comparten mediante el gestor del Director, así que al volver a la escena desde el
+                // menú no se vuelven a decodificar. La subida a la GPU de las nuevas se hace en el
+                // hilo de carga (o, si no está disponible, se reparte entre los siguientes
+                // fotogramas) para que el mensaje de carga se siga dibujando con fluidez:
 
-                if (texture) context->add (texture); else state = ERROR;
+                if (!texture) state = ERROR;
 
                 // Cuando se han terminado de cargar todas las texturas se pueden crear los sprites que
                 // las usarán e iniciar el juego:
@@ -237,10 +340,21 @@ namespace example
         else
         if (timer.get_elapsed_seconds () > 1.f)         // Si las texturas se han cargado muy rápido
         {                                               // se espera un segundo desde el inicio de
-            create_sprites ();                          // la carga antes de pasar al juego para que
-            restart_game   ();                          // el mensaje de carga no aparezca y desaparezca
+                                                        // la carga antes de pasar al juego para que
+                                                        // el mensaje de carga no aparezca y desaparezca
                                                         // demasiado rápido.
-            state = RUNNING;
+
+            // Tampoco se empieza hasta que todas las texturas han terminado de subirse a la GPU:
+
+            Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+            if (context && !context->has_pending_uploads ())
+            {
+                create_sprites ();
+                restart_game   ();
+
+                state = RUNNING;
+            }
         }
     }
 
@@ -464,9 +578,74 @@ barrow = bbutton.get();
         bigturtle1          = bigturtle1_handle.get();
         bigturtle2        = bigturtle2_handle.get();
 
+        create_lanes ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // Los carriles de transportes van primero y en el orden en el que se comprobaban antes en
+    // update_ai() (troncos grandes, troncos pequeños y tortugas), ya que si la rana está sobre
+    // varios a la vez se queda con la velocidad del último.
+
+    void Game_Scene::create_lanes ()
+    {
+        lanes.clear ();
+
+        lanes.emplace_back (Lane::TRANSPORTS, right_border, -100.f, truck_speed);
+        lanes.back ().add (biglog1ml);
+
+        lanes.emplace_back (Lane::TRANSPORTS, right_border, -100.f, truck_speed);
+        lanes.back ().add (biglog1ll);
+
+        lanes.emplace_back (Lane::TRANSPORTS, right_border, -100.f, car2_speed);
+        lanes.back ().add (smalllog1);
+        lanes.back ().add (smalllog2);
+
+        lanes.emplace_back (Lane::TRANSPORTS, left_border, canvas_width + 80.f, -car1_speed);
+        lanes.back ().add (smallturtle1);
+        lanes.back ().add (smallturtle2);
+
+        lanes.emplace_back (Lane::TRANSPORTS, left_border, canvas_width + 120.f, -car1_speed);
+        lanes.back ().add (bigturtle1);
+        lanes.back ().add (bigturtle2);
+
+        lanes.emplace_back (Lane::VEHICLES, left_border, canvas_width + 40.f);
+        lanes.back ().add (caryellow1);
+        lanes.back ().add (caryellow2);
 
+        lanes.emplace_back (Lane::VEHICLES, left_border, canvas_width + 40.f);
+        lanes.back ().add (carwhite1);
+        lanes.back ().add (carwhite2);
 
+        lanes.emplace_back (Lane::VEHICLES, left_border, canvas_width + 40.f);
+        lanes.back ().add (carblue1);
+        lanes.back ().add (carblue2);
 
+        lanes.emplace_back (Lane::VEHICLES, right_border, -100.f);
+        lanes.back ().add (truckmidlane1);
+
+        lanes.emplace_back (Lane::VEHICLES, right_border, -100.f);
+        lanes.back ().add (trucklastlane1);
+
+        // El resto de sprites (la rana y el decorado) se siguen actualizando desde run_simulation():
+
+        std::vector< Sprite * > obstacles;
+
+        for (const Lane & lane : lanes)
+        {
+            obstacles.insert (obstacles.end (), lane.get_obstacles ().begin (), lane.get_obstacles ().end ());
+        }
+
+        obstacle_count = obstacles.size ();
+
+        scenery.clear ();
+
+        for (auto & sprite : sprites)
+        {
+            if (std::find (obstacles.begin (), obstacles.end (), sprite.get ()) == obstacles.end ())
+            {
+                scenery.push_back (sprite.get ());
+            }
+        }
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -477,6 +656,8 @@ barrow = bbutton.get();
     {
 
         follow_target=false;
+        restarted    =true;
+        touch_predictor.clear ();
 
 
 
@@ -639,48 +820,72 @@ barrow = bbutton.get();
 
     void Game_Scene::run_simulation (float time)
     {
-        // Se actualiza el estado de todos los sprites:
+        // Se actualiza el estado de todos los sprites. Los obstáculos se mueven por carriles, que
+        // además los recolocan cuando salen por uno de los bordes:
 
-        for (auto & sprite : sprites)
+        for (Sprite * sprite : scenery)
         {
             sprite->update (time);
         }
 
+        update_lanes (time);
+
+        restarted = false;
+
         update_ai   ();
         update_user ();
 
-        // Se comprueban las posibles colisiones de la bola con los bordes y con los players:
+        // Los bordes se comprobaban después de update_user(), así que si se ha reiniciado la partida
+        // se vuelven a comprobar con las posiciones iniciales:
 
-        check_ball_collisions ();
+        if (restarted)
+        {
+            for (Lane & lane : lanes) lane.wrap ();
+        }
     }
 
     // ---------------------------------------------------------------------------------------------
-    // Usando un algoritmo sencillo se controla automáticamente el comportamiento del jugador
-    // izquierdo.
+    // Cada carril solo toca sus propios sprites. Los contactos con la rana se combinan después en
+    // update_ai() y update_user() recorriendo los carriles siempre en el mismo orden, de modo que el
+    // resultado es el mismo se repartan o no entre núcleos.
 
-    void Game_Scene::update_ai () {
-
-        if (biglog1ml->contains(right_player->get_position())||biglog1ll->contains(right_player->get_position()))
+    void Game_Scene::update_lanes (float time)
+    {
+        if (obstacle_count >= parallel_obstacle_count)
         {
-            right_player->set_speed_x (truck_speed);
-        }
+            if (!jobs) jobs.reset (new basics::Job_System);
 
-        if (smalllog1->contains(right_player->get_position())||smalllog2->contains(right_player->get_position()))
-        {
-            right_player->set_speed_x (car2_speed);
+            if (jobs->get_lane_count () > 1)
+            {
+                jobs->parallel_for (0, lanes.size (), 1, [this, time] (size_t first, size_t last)
+                {
+                    for ( ; first < last; ++first) lanes[first].step (time);
+                });
+
+                return;
+            }
         }
 
-        if (smallturtle1->contains(right_player->get_position())||smallturtle2->contains(right_player->get_position())
-        ||bigturtle1->contains(right_player->get_position())||bigturtle2->contains(right_player->get_position())
-        )
+        for (Lane & lane : lanes)
         {
-            right_player->set_speed_x (-car1_speed);
+            lane.step (time);
         }
+    }
 
+    // ---------------------------------------------------------------------------------------------
+    // La rana se mueve con el transporte sobre el que está.
 
+    void Game_Scene::update_ai ()
+    {
+        const Point2f & position = right_player->get_position ();
 
-
-
+        for (const Lane & lane : lanes)
+        {
+            if (lane.carries (position))
+            {
+                right_player->set_speed_x (lane.get_carry_speed ());
+            }
+        }
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -692,13 +897,18 @@ barrow = bbutton.get();
     {
 
 
-     if (right_player->intersects (*caryellow1)||right_player->intersects (*caryellow2)
-     ||right_player->intersects (*carblue1)||right_player->intersects (*carblue2)
-     ||right_player->intersects (*carwhite1)||right_player->intersects (*carwhite2)
-      ||right_player->intersects (*truckmidlane1)||right_player->intersects (*trucklastlane1)
-     ) {
-restart_game();
-     }
+        Lane::Bounds frog;
+
+        right_player->get_bounds (frog.left, frog.bottom, frog.right, frog.top);
+
+        for (const Lane & lane : lanes)
+        {
+            if (lane.hits (frog))
+            {
+                restart_game ();
+                break;
+            }
+        }
 
 
 
@@ -744,152 +954,52 @@ restart_game();
 
 
 
-            if(larrow->contains(touch_location))
+            // Se usa la posición en la que se estima que estará el dedo cuando se vea el fotograma:
+
+            Point2f target = touch_location;
+
+            basics::Touch_Predictor::Sample predicted;
+
+            if (touch_predictor.predict (touch_pointer_id, predicted))
+            {
+                target = { predicted.x, predicted.y };
+            }
+
+            if(larrow->contains(target))
             {
                 right_player->set_speed_x (-player_speed);
             }
-            if(rarrow->contains(touch_location))
+            if(rarrow->contains(target))
             {
                 right_player->set_speed_x (+player_speed);
             }
-            if(tarrow->contains(touch_location))
+            if(tarrow->contains(target))
             {
                 right_player->set_speed_y (+player_speed);
             }
-            if(barrow->contains(touch_location))
+            if(barrow->contains(target))
             {
                 right_player->set_speed_y (-player_speed);
             }
+
+            highlight_arrows (true, target);
         }
         else {
             right_player->set_speed_y(0);
             right_player->set_speed_x(0);
+
+            highlight_arrows (false, touch_location);
         }
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    void Game_Scene::check_ball_collisions ()
+    void Game_Scene::highlight_arrows (bool pressed, const Point2f & location)
     {
-
-
-
-        if (caryellow1 ->intersects (*left_border))
-        {
-            caryellow1->set_position_x (canvas_width+40);
-
-        }
-
-
-        if (caryellow2->intersects (*left_border))
-        {
-            caryellow2->set_position_x (canvas_width+40);
-
-        }
-
-
-
-
-        if (carwhite1 ->intersects (*left_border))
+        for (Sprite * arrow : { larrow, rarrow, tarrow, barrow })
         {
-            carwhite1->set_position_x (canvas_width+40);
-
+            arrow->set_scale (pressed && arrow->contains (location) ? 1.15f : 1.f);
         }
-
-
-        if (carwhite2->intersects (*left_border))
-        {
-            carwhite2->set_position_x (canvas_width+40);
-
-        }
-
-
-
-
-        if (carblue1 ->intersects (*left_border))
-        {
-            carblue1->set_position_x (canvas_width+40);
-
-        }
-
-
-        if (carblue2->intersects (*left_border))
-        {
-            carblue2->set_position_x (canvas_width+40);
-
-        }
-
-        if (bigturtle1->intersects (*left_border))
-        {
-            bigturtle1->set_position_x (canvas_width+120);
-
-        }
-
-        if (bigturtle2->intersects (*left_border))
-        {
-            bigturtle2->set_position_x (canvas_width+120);
-
-        }
-
-        if (smallturtle1->intersects (*left_border))
-        {
-            smallturtle1->set_position_x (canvas_width+80);
-
-        }
-
-        if (smallturtle2->intersects (*left_border))
-        {
-            smallturtle2->set_position_x (canvas_width+80);
-
-        }
-
-
-
-        if (truckmidlane1 ->intersects (*right_border))
-        {
-            truckmidlane1->set_position_x (-100);
-
-        }
-
-
-
-
-        if (trucklastlane1 ->intersects (*right_border))
-        {
-            trucklastlane1->set_position_x (-100);
-
-        }
-
-        if (biglog1ll ->intersects (*right_border))
-        {
-            biglog1ll->set_position_x (-100);
-
-        }
-
-        if (biglog1ml ->intersects (*right_border))
-        {
-            biglog1ml->set_position_x (-100);
-
-        }
-
-        if (smalllog1 ->intersects (*right_border))
-        {
-            smalllog1->set_position_x (-100);
-
-        }
-        if (smalllog2 ->intersects (*right_border))
-        {
-            smalllog2->set_position_x (-100);
-
-        }
-
-
-
-
-
-
-
-
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -11,16 +11,20 @@
 #ifndef GAME_SCENE_HEADER
 #define GAME_SCENE_HEADER
 
-#include <map>
 #include <list>
 #include <memory>
+#include <vector>
 
 #include <basics/Canvas>
 #include <basics/Id>
+#include <basics/Job_System>
 #include <basics/Scene>
 #include <basics/Texture_2D>
 #include <basics/Timer>
+#include <basics/Tiny_Map>
+#include <basics/Touch_Predictor>
 
+#include "Lane.hpp"
 #include "Sprite.hpp"
 
 namespace example
@@ -30,6 +34,7 @@ namespace example
     using basics::Timer;
     using basics::Canvas;
     using basics::Texture_2D;
+    using basics::Tiny_Map;
 
     class Game_Scene : public basics::Scene
     {
@@ -39,7 +44,7 @@ namespace example
         typedef std::shared_ptr < Sprite     >     Sprite_Handle;
         typedef std::list< Sprite_Handle     >     Sprite_List;
         typedef std::shared_ptr< Texture_2D  >     Texture_Handle;
-        typedef std::map< Id, Texture_Handle >     Texture_Map;
+        typedef Tiny_Map< Id, Texture_Handle, 24 > Texture_Map;
         typedef basics::Graphics_Context::Accessor Context;
 
         /**
@@ -105,6 +110,8 @@ namespace example
         static constexpr float   ball_speed = 400.f;        ///< Velocidad a la que se mueve la bola (en unideades virtuales por segundo).
         static constexpr float player_speed = 450.f;        ///< Velocidad a la que se mueven ambos jugadores (en unideades virtuales por segundo).
 
+        static constexpr unsigned parallel_obstacle_count = 1024;   ///< A partir de cuántos obstáculos se reparten los carriles entre núcleos.
+
     private:
 
         State          state;                               ///< Estado de la escena.
@@ -166,6 +173,12 @@ namespace example
         Sprite      *smalllog1;
         Sprite      *smalllog2;
 
+        std::vector< Lane     > lanes;                      ///< Carriles en el orden en el que se combinan sus contactos con la rana.
+        std::vector< Sprite * > scenery;                    ///< Sprites que no pertenecen a ningún carril (incluida la rana).
+        size_t                  obstacle_count;             ///< Obstáculos que hay entre todos los carriles.
+        std::unique_ptr< basics::Job_System > jobs;         ///< Solo se crea si hay obstáculos suficientes.
+        bool                    restarted;                  ///< true si restart_game() se ha llamado en el paso actual.
+
         Sprite      *larrow;
         Sprite      *rarrow;
         Sprite      *tarrow;
@@ -177,6 +190,8 @@ namespace example
         float          user_target_y;                       ///< Coordenada Y hacia donde debe ir el player del usuario cuando este toca la pantalla.
         float          user_target_x;                       ///< Coordenada X hacia donde debe ir el player del usuario cuando este toca la pantalla.
         Point2f touch_location;
+        int32_t        touch_pointer_id;                    ///< Puntero que se sigue (el último que ha empezado a tocar).
+        basics::Touch_Predictor touch_predictor;            ///< Estima dónde estará el dedo cuando se muestre el fotograma.
 
         Timer          timer;                               ///< Cronómetro usado para medir intervalos de tiempo
 
@@ -226,12 +241,24 @@ namespace example
          */
         void update (float time) override;
 
+        /**
+         * Se invoca justo antes de render() con los toques que han llegado durante update() para
+         * resaltar ya la flecha que se está pulsando.
+         */
+        void latch (const basics::Event & event) override;
+
         /**
          * Este método se invoca automáticamente una vez por fotograma para que la escena
          * dibuje su contenido.
          */
         void render (Context & context) override;
 
+        /**
+         * Si el Director dibuja en otro hilo, copia los sprites en lugar de dibujarlos. Mientras se
+         * cargan las texturas devuelve false para que se dibuje con render().
+         */
+        bool capture (basics::Render_Snapshot & snapshot) override;
+
     private:
 
         /**
@@ -245,6 +272,11 @@ namespace example
          */
         void create_sprites ();
 
+        /**
+         * Agrupa los obstáculos por carriles. Se llama después de crear los sprites.
+         */
+        void create_lanes ();
+
         /**
          * Se llama cada vez que se debe reiniciar el juego. En concreto la primera vez y cada
          * vez que un jugador pierde.
@@ -262,6 +294,12 @@ namespace example
          */
         void run_simulation (float time);
 
+        /**
+         * Mueve los obstáculos de todos los carriles y recoloca los que salen de la pantalla. Con
+         * muchos obstáculos cada carril se procesa en un trabajo distinto.
+         */
+        void update_lanes (float time);
+
         /**
          * Controla el player izquierdo usando una inteligencia artificial muy básica.
          */
@@ -273,9 +311,10 @@ namespace example
         void update_user ();
 
         /**
-         * Comprueba las colisiones de la bola con el escenario y con los players.
+         * Agranda la flecha que contiene el punto indicado (si se está pulsando) y restablece las
+         * demás.
          */
-        void check_ball_collisions ();
+        void highlight_arrows (bool pressed, const Point2f & location);
 
         /**
          * Dibuja la textura con el mensaje de carga mientras el estado de la escena es LOADING.
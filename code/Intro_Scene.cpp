@@ -103,7 +103,7 @@ namespace example
 
             if (logo_texture)
             {
-                context->add (logo_texture);
+                graphics_resources.add (context, logo_texture);
 
                 timer.reset ();
 
@@ -0,0 +1,92 @@
+/*
+ * LANE
+ * Copyright © 2020+ Daniel Sanchez Gamo
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * danielsanchezgamo@gmail.com
+ */
+
+#include <algorithm>
+#include "Lane.hpp"
+
+namespace example
+{
+
+    void Lane::step (float time)
+    {
+        bucket.clear ();
+
+        for (Sprite * obstacle : obstacles)
+        {
+            obstacle->update (time);
+
+            Bounds bounds;
+
+            obstacle->get_bounds (bounds.left, bounds.bottom, bounds.right, bounds.top);
+
+            if (bucket.empty ())
+            {
+                extent = bounds;
+            }
+            else
+            {
+                extent.left   = std::min (extent.left,   bounds.left  );
+                extent.bottom = std::min (extent.bottom, bounds.bottom);
+                extent.right  = std::max (extent.right,  bounds.right );
+                extent.top    = std::max (extent.top,    bounds.top   );
+            }
+
+            bucket.push_back (bounds);
+        }
+
+        wrap ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Lane::wrap ()
+    {
+        for (Sprite * obstacle : obstacles)
+        {
+            if (obstacle->intersects (*border))
+            {
+                obstacle->set_position_x (reentry_x);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // Las comparaciones son las mismas que hacen Sprite::intersects() y Sprite::contains() para que
+    // el resultado sea idéntico al de comprobar los sprites uno a uno. Si no se toca el rectángulo
+    // que engloba el carril no hace falta mirar cada obstáculo.
+
+    bool Lane::hits (const Bounds & bounds) const
+    {
+        auto overlaps = [&bounds] (const Bounds & other)
+        {
+            return !(other.left >= bounds.right || other.right <= bounds.left || other.bottom >= bounds.top || other.top <= bounds.bottom);
+        };
+
+        if (kind != VEHICLES || bucket.empty () || !overlaps (extent)) return false;
+
+        return std::any_of (bucket.begin (), bucket.end (), overlaps);
+    }
+
+    bool Lane::carries (const Point2f & point) const
+    {
+        const float x = point.coordinates.x ();
+        const float y = point.coordinates.y ();
+
+        auto contains = [x, y] (const Bounds & bounds)
+        {
+            return x > bounds.left && y > bounds.bottom && x < bounds.right && y < bounds.top;
+        };
+
+        if (kind != TRANSPORTS || bucket.empty () || !contains (extent)) return false;
+
+        return std::any_of (bucket.begin (), bucket.end (), contains);
+    }
+
+}
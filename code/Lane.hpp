@@ -0,0 +1,105 @@
+/*
+ * LANE
+ * Copyright © 2020+ Daniel Sanchez Gamo
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * danielsanchezgamo@gmail.com
+ */
+
+#ifndef LANE_HEADER
+#define LANE_HEADER
+
+#include <vector>
+
+#include "Sprite.hpp"
+
+namespace example
+{
+
+    /**
+     * Carril con obstáculos que se mueven en horizontal y vuelven a entrar por el lado contrario
+     * al tocar un borde. Los carriles no comparten sprites, así que step() se puede llamar en
+     * paralelo para carriles distintos. Las consultas (hits(), carries()) usan los límites que
+     * tenían los obstáculos justo después de moverse, antes de recolocar los que salen.
+     */
+    class Lane
+    {
+    public:
+
+        enum Kind
+        {
+            VEHICLES,                           ///< Tocarlos reinicia la partida.
+            TRANSPORTS                          ///< Arrastran a la rana cuando está encima.
+        };
+
+        struct Bounds
+        {
+            float left, bottom, right, top;
+        };
+
+    private:
+
+        Kind                   kind;
+        std::vector< Sprite * > obstacles;
+        const Sprite         * border;          ///< Borde que hace que los obstáculos vuelvan a entrar.
+        float                  reentry_x;       ///< Posición X en la que vuelven a entrar.
+        float                  carry_speed;     ///< Velocidad que transmite a la rana (solo TRANSPORTS).
+
+        std::vector< Bounds >  bucket;          ///< Límites de los obstáculos tras el último step().
+        Bounds                 extent;          ///< Rectángulo que engloba todo el bucket.
+
+    public:
+
+        Lane(Kind kind, const Sprite * border, float reentry_x, float carry_speed = 0.f)
+        :
+            kind       (kind),
+            border     (border),
+            reentry_x  (reentry_x),
+            carry_speed(carry_speed),
+            extent     { 0.f, 0.f, 0.f, 0.f }
+        {
+        }
+
+        void add (Sprite * obstacle)
+        {
+            obstacles.push_back (obstacle);
+            bucket.reserve (obstacles.size ());
+        }
+
+        const std::vector< Sprite * > & get_obstacles () const
+        {
+            return obstacles;
+        }
+
+        float get_carry_speed () const
+        {
+            return carry_speed;
+        }
+
+        /**
+         * Mueve los obstáculos, guarda sus límites y recoloca los que tocan el borde.
+         */
+        void step (float time);
+
+        /**
+         * Recoloca los obstáculos que tocan el borde.
+         */
+        void wrap ();
+
+        /**
+         * @return true si es un carril de vehículos y alguno se solapa con el rectángulo indicado.
+         */
+        bool hits (const Bounds & bounds) const;
+
+        /**
+         * @return true si es un carril de transportes y alguno contiene el punto indicado.
+         */
+        bool carries (const Point2f & point) const;
+
+    };
+
+}
+
+#endif
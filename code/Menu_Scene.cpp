@@ -53,7 +53,7 @@ namespace example
                 {
                     // Se determina qué opción se ha tocado:
 
-                    Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
+                    Point2f touch_location = { event.touch.x, event.touch.y };
                     int     option_touched = option_at (touch_location);
 
                     // Solo se puede tocar una opción a la vez (para evitar selecciones múltiples),
@@ -75,7 +75,7 @@ namespace example
 
                     // Se determina qué opción se ha dejado de tocar la última y se actúa como corresponda:
 
-                    Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
+                    Point2f touch_location = { event.touch.x, event.touch.y };
 
                     if (option_at (touch_location) == PLAY)
                     {
@@ -105,7 +105,7 @@ namespace example
             {
                 // Se carga el atlas:
 
-                atlas.reset (new Atlas("menu-scene/main-menu.sprites", context));
+                atlas.reset (new Atlas("menu-scene/main-menu.sprites", context, &director.get_texture_manager ()));
 
                 // Si el atlas se ha podido cargar el estado es READY y, en otro caso, es ERROR:
 
@@ -25,26 +25,49 @@ namespace example
         scale    = 1.f;
         speed    = { 0.f, 0.f };
         visible  = true;
+        trimmed_bounds = false;
 
     }
 
+    void Sprite::get_bounds (float & left, float & bottom, float & right, float & top) const
+    {
+        left   = get_left_x   ();
+        bottom = get_bottom_y ();
+        right  = left   + size.width;
+        top    = bottom + size.height;
+
+        if (trimmed_bounds && texture->is_trimmed ())
+        {
+            // El recorte está en texels de la textura (con el origen arriba a la izquierda), por
+            // lo que se escala al tamaño del sprite:
+
+            const Texture_2D::Trim & trim = texture->get_trim ();
+
+            float horizontal_scale = size.width  / texture->get_width  ();
+            float   vertical_scale = size.height / texture->get_height ();
+
+            left  += trim.left * horizontal_scale;
+            right  = left + trim.width * horizontal_scale;
+            top   -= trim.top  *   vertical_scale;
+            bottom = top  - trim.height * vertical_scale;
+        }
+    }
+
     bool Sprite::intersects (const Sprite & other)
     {
         // Se determinan las coordenadas de la esquina inferior izquierda y de la superior derecha
         // de este sprite:
 
-        float this_left    = this->get_left_x   ();
-        float this_bottom  = this->get_bottom_y ();
-        float this_right   = this_left   + this->size.width;
-        float this_top     = this_bottom + this->size.height;
+        float this_left, this_bottom, this_right, this_top;
+
+        this->get_bounds (this_left, this_bottom, this_right, this_top);
 
         // Se determinan las coordenadas de la esquina inferior izquierda y de la superior derecha
         // del otro sprite:
 
-        float other_left   = other.get_left_x   ();
-        float other_bottom = other.get_bottom_y ();
-        float other_right  = other_left   + other.size.width;
-        float other_top    = other_bottom + other.size.height;
+        float other_left, other_bottom, other_right, other_top;
+
+        other.get_bounds (other_left, other_bottom, other_right, other_top);
 
         // Se determina si los rectángulos envolventes de ambos sprites se solapan:
 
@@ -53,37 +76,17 @@ namespace example
 
     bool Sprite::contains (const Point2f & point)
     {
-        float this_left = this->get_left_x ();
+        float this_left, this_bottom, this_right, this_top;
 
-        if (point.coordinates.x () > this_left)
-        {
-            float this_bottom = this->get_bottom_y ();
-
-            if (point.coordinates.y () > this_bottom)
-            {
-                float this_right = this_left + this->size.width;
-
-                if (point.coordinates.x () < this_right)
-                {
-                    float this_top = this_bottom + this->size.height;
-
-                    if (point.coordinates.y () < this_top)
-                    {
-                        return true;
-                    }
-                }
-            }
-        }
+        get_bounds (this_left, this_bottom, this_right, this_top);
 
-        return false;
+        return point.coordinates.x () > this_left  && point.coordinates.y () > this_bottom
+            && point.coordinates.x () < this_right && point.coordinates.y () < this_top;
     }
 
     bool Sprite::checkbutton (float x, float y)
     {
-        float this_left = this->get_left_x ();
-        float this_bottom = this->get_bottom_y ();
-
-        return x > this_left && y > this_bottom && x < this_left + size.width && y < this_bottom + size.height;
+        return contains ({ x, y });
     }
 
 
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <basics/Canvas>
+#include <basics/Render_Snapshot>
 #include <basics/Texture_2D>
 #include <basics/Vector>
 
@@ -39,6 +40,7 @@ namespace example
         Vector2f     speed;                     ///< Velocidad a la que se mueve el sprite. Usar el valor por defecto (0,0) para dejarlo quieto.
 
         bool         visible;                   ///< Indica si el sprite se debe actualizar y dibujar o no. Por defecto es true.
+        bool         trimmed_bounds;            ///< Si es true las colisiones solo usan la parte visible de una textura recortada. Por defecto es false.
 
     public:
 
@@ -154,6 +156,16 @@ namespace example
             speed.coordinates.y () = new_speed_y;
         }
 
+        /**
+         * Con texturas cargadas con Texture_2D::Options::trim permite que intersects(), contains()
+         * y checkbutton() usen solo la zona que queda tras recortar los bordes transparentes en
+         * lugar del tamaño lógico del sprite.
+         */
+        void set_trimmed_bounds (bool enabled)
+        {
+            trimmed_bounds = enabled;
+        }
+
     public:
 
         /**
@@ -193,6 +205,12 @@ namespace example
 
     public:
 
+        /**
+         * Calcula el rectángulo que se usa para detectar colisiones (el mismo que usan intersects()
+         * y contains()).
+         */
+        void get_bounds (float & left, float & bottom, float & right, float & top) const;
+
         /**
          * Actualiza la posición del sprite automáticamente en función de su velocidad, pero
          * solo cuando es visible.
@@ -221,6 +239,18 @@ namespace example
             }
         }
 
+        /**
+         * Igual que render(), pero copia el sprite en una instantánea que se dibujará en otro hilo.
+         * @param snapshot Instantánea del fotograma que se está preparando.
+         */
+        virtual void capture (basics::Render_Snapshot & snapshot)
+        {
+            if (visible)
+            {
+                snapshot.add_sprite (texture, position, size * scale, anchor);
+            }
+        }
+
     };
 
 }
@@ -22,7 +22,7 @@
     namespace basics
     {
 
-        std::shared_ptr< Asset > Asset::open (const std::string & path)
+        std::shared_ptr< Asset > Asset::open_file (const std::string & path)
         {
             std::shared_ptr< Asset > asset(new internal::Android_Asset(path));
 
@@ -34,16 +34,6 @@
             return asset;
         }
 
-        bool Asset::exists (const std::string & path)
-        {
-            return internal::Android_Asset(path).good ();
-        }
-
-        size_t Asset::size (const std::string & path)
-        {
-            return internal::Android_Asset(path).size ();
-        }
-
     }
 
 #endif
@@ -23,7 +23,13 @@
 
             bool switch_on  () override
             {
-                return android_sensor_manager.switch_on (Android_Sensor_Manager::ACCELEROMETER);
+                return android_sensor_manager.switch_on (Android_Sensor_Manager::ACCELEROMETER, sampling_rate);
+            }
+
+            bool set_sampling_rate (float samples_per_second) override
+            {
+                return Accelerometer::set_sampling_rate (samples_per_second) &&
+                       android_sensor_manager.set_sampling_rate (Android_Sensor_Manager::ACCELEROMETER, samples_per_second);
             }
 
             void switch_off () override
@@ -16,6 +16,8 @@
 
     #include "Android_Asset.hpp"
     #include <android/asset_manager.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
     #include "Native_Activity.hpp"
 
     namespace basics { namespace internal
@@ -30,13 +32,21 @@
                 AASSET_MODE_UNKNOWN
             );
 
-            cursor = 0;
-            failed = handle == nullptr;
-            at_end = false;
+            cursor       = 0;
+            failed       = handle == nullptr;
+            at_end       = false;
+            view         = { nullptr, 0 };
+            mapping      = nullptr;
+            mapping_size = 0;
         }
 
         Android_Asset::~Android_Asset()
         {
+            if (mapping != nullptr)
+            {
+                munmap (mapping, mapping_size), mapping = nullptr;
+            }
+
             if (handle != nullptr)
             {
                 AAsset_close (handle), handle = nullptr;
@@ -102,6 +112,33 @@
             return data;
         }
 
+        size_t Android_Asset::read_some (byte * buffer, size_t size)
+        {
+            size_t total = 0;
+
+            // AAsset_read() puede devolver menos bytes de los pedidos sin haber llegado al final:
+
+            while (good () && total < size)
+            {
+                int result = AAsset_read (handle, buffer + total, size - total);
+
+                if (result > 0)
+                {
+                    total += size_t(result);
+                }
+                else
+                {
+                    if (result == 0) at_end = true; else failed = true;
+
+                    break;
+                }
+            }
+
+            cursor += total;
+
+            return total;
+        }
+
         bool Android_Asset::read_all (std::vector< byte > & buffer)
         {
             if (good ())
@@ -130,6 +167,71 @@
             return false;
         }
 
+        Asset::View Android_Asset::map (Access access)
+        {
+            if (good () && view.data == nullptr)
+            {
+                // Los assets que se guardan sin comprimir en el APK (como los PNG) tienen un
+                // descriptor de archivo y se pueden proyectar directamente. Los demás se
+                // descomprimen en un búfer que pertenece al propio AAsset:
+
+                if (!map_file_descriptor (access))
+                {
+                    const void * buffer = AAsset_getBuffer (handle);
+
+                    if (buffer)
+                    {
+                        view = { static_cast< const byte * >(buffer), size () };
+                    }
+                    else
+                        failed = true;
+                }
+            }
+
+            return view;
+        }
+
+        bool Android_Asset::map_file_descriptor (Access access)
+        {
+            off_t start;
+            off_t length;
+            int   file_descriptor = AAsset_openFileDescriptor (handle, &start, &length);
+
+            if (file_descriptor < 0)
+            {
+                return false;
+            }
+
+            // mmap() requiere que el desplazamiento sea múltiplo del tamaño de página:
+
+            off_t  page_size     = off_t(sysconf (_SC_PAGESIZE));
+            off_t  aligned_start = start & ~(page_size - 1);
+            size_t padding       = size_t(start - aligned_start);
+
+            mapping_size = size_t(length) + padding;
+            mapping      = mmap (nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file_descriptor, aligned_start);
+
+            close (file_descriptor);
+
+            if (mapping == MAP_FAILED)
+            {
+                mapping = nullptr;
+
+                return false;
+            }
+
+            madvise (mapping, mapping_size, access == RANDOM ? MADV_RANDOM : MADV_SEQUENTIAL);
+
+            if (access == SEQUENTIAL)
+            {
+                madvise (mapping, mapping_size, MADV_WILLNEED);
+            }
+
+            view = { static_cast< const byte * >(mapping) + padding, size_t(length) };
+
+            return true;
+        }
+
         bool Android_Asset::read (uint8_t * buffer, size_t size)
         {
             if (size > 0)
@@ -27,6 +27,9 @@
             size_t   cursor;
             bool     failed;
             bool     at_end;
+            View     view;                      ///< Resultado de map() (nulo si no se ha llamado).
+            void   * mapping;                   ///< Páginas proyectadas con mmap() o nullptr.
+            size_t   mapping_size;
 
         public:
 
@@ -43,12 +46,15 @@
             bool   seek (ptrdiff_t offset, Anchor = CURRENT) override;
             size_t tell () const override;
             byte   read () override;
+            size_t read_some (byte * buffer, size_t size) override;
             bool   read_all (std::vector< byte > & buffer) override;
             bool   read_all (std::string & buffer) override;
+            View   map      (Access access) override;
 
         private:
 
             bool read (uint8_t * buffer, size_t size);
+            bool map_file_descriptor (Access access);
 
         };
 
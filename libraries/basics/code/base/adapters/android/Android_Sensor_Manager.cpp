@@ -12,6 +12,7 @@
 
 #if defined(BASICS_ANDROID_OS)
 
+    #include <algorithm>
     #include "Native_Activity.hpp"
     #include "Android_Sensor_Manager.hpp"
 
@@ -89,7 +90,7 @@
 
         // -----------------------------------------------------------------------------------------
 
-        bool Android_Sensor_Manager::switch_on (Sensor sensor)
+        bool Android_Sensor_Manager::switch_on (Sensor sensor, float samples_per_second)
         {
             if (manager)
             {
@@ -109,7 +110,7 @@
                     {
                         if (ASensorEventQueue_enableSensor (event_queue, accelerometer_sensor) == 0)
                         {
-                            ASensorEventQueue_setEventRate (event_queue, accelerometer_sensor, (1000L / 50) * 1000);
+                            set_sampling_rate (sensor, samples_per_second);
 
                             return true;
                         }
@@ -138,9 +139,32 @@
                 {
                     ASensorEventQueue_disableSensor (event_queue, sensor_handler);
                 }
+
+                switch (sensor)
+                {
+                    case ACCELEROMETER: accelerometer_sensor = nullptr; break;
+                    case GYROSCOPE:         gyroscope_sensor = nullptr; break;
+                }
             }
         }
 
+        // -----------------------------------------------------------------------------------------
+
+        bool Android_Sensor_Manager::set_sampling_rate (Sensor sensor, float samples_per_second)
+        {
+            const ASensor * sensor_handler = sensor == ACCELEROMETER ? accelerometer_sensor : gyroscope_sensor;
+
+            if (!event_queue || !sensor_handler) return true;
+
+            // El periodo se pide en microsegundos y no puede ser menor que el mínimo del sensor:
+
+            int32_t period = int32_t(1000000.f / samples_per_second);
+
+            period = std::max (period, ASensor_getMinDelay (sensor_handler));
+
+            return ASensorEventQueue_setEventRate (event_queue, sensor_handler, period) >= 0;
+        }
+
     }}
 
 #endif
@@ -69,9 +69,14 @@
                 ASensorEventQueue * create_event_queue (ALooper * looper);
 
                 bool is_available (Sensor sensor);
-                bool switch_on    (Sensor sensor);
+                bool switch_on    (Sensor sensor, float samples_per_second);
                 void switch_off   (Sensor sensor);
 
+                /**
+                 * Si el sensor no está encendido no hace nada (se usará al encenderlo).
+                 */
+                bool set_sampling_rate (Sensor sensor, float samples_per_second);
+
             };
 
             extern Android_Sensor_Manager & android_sensor_manager;
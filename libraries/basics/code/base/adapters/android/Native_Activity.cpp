@@ -154,7 +154,8 @@
                                         (
                                             event.acceleration.x,
                                             event.acceleration.y,
-                                            event.acceleration.z
+                                            event.acceleration.z,
+                                            event.timestamp
                                         );
                                     }
 
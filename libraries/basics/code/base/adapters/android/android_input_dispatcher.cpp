@@ -36,13 +36,17 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-started));
-
-                            event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                            event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                            event[ID(y) ] = AMotionEvent_getY         (android_event, index);
-
-                            director.handle (event);
+                            director.handle
+                            (
+                                Event::make_touch
+                                (
+                                    ID(touch-started),
+                                    AMotionEvent_getX         (android_event, index),
+                                    AMotionEvent_getY         (android_event, index),
+                                    AMotionEvent_getPointerId (android_event, index),
+                                    AMotionEvent_getEventTime (android_event)
+                                )
+                            );
 
                             break;
                         }
@@ -52,18 +56,42 @@
                             // Parece ser que para el evento de movimiento el index que indica action es siempre cero,
                             // por lo que no veo clara la manera de identificar el puntero que se ha movido. Por ello
                             // se envían eventos de movimiento para todos los punteros...
+                            // Android agrupa las muestras intermedias en el propio evento (historical). Se
+                            // envían todas en orden y el Director las junta por fotograma en el historial.
 
                             size_t pointer_count = AMotionEvent_getPointerCount (android_event);
+                            size_t history_size  = AMotionEvent_getHistorySize  (android_event);
 
                             for (size_t index = 0; index < pointer_count; ++index)
                             {
-                                Event event(ID(touch-moved));
-
-                                event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                                event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                                event[ID(y) ] = AMotionEvent_getY         (android_event, index);
-
-                                director.handle (event);
+                                int32_t pointer_id = AMotionEvent_getPointerId (android_event, index);
+
+                                for (size_t sample = 0; sample < history_size; ++sample)
+                                {
+                                    director.handle
+                                    (
+                                        Event::make_touch
+                                        (
+                                            ID(touch-moved),
+                                            AMotionEvent_getHistoricalX         (android_event, index, sample),
+                                            AMotionEvent_getHistoricalY         (android_event, index, sample),
+                                            pointer_id,
+                                            AMotionEvent_getHistoricalEventTime (android_event, sample)
+                                        )
+                                    );
+                                }
+
+                                director.handle
+                                (
+                                    Event::make_touch
+                                    (
+                                        ID(touch-moved),
+                                        AMotionEvent_getX         (android_event, index),
+                                        AMotionEvent_getY         (android_event, index),
+                                        pointer_id,
+                                        AMotionEvent_getEventTime (android_event)
+                                    )
+                                );
                             }
 
                             break;
@@ -75,13 +103,17 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-ended));
-
-                            event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                            event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                            event[ID(y) ] = AMotionEvent_getY         (android_event, index);
-
-                            director.handle (event);
+                            director.handle
+                            (
+                                Event::make_touch
+                                (
+                                    ID(touch-ended),
+                                    AMotionEvent_getX         (android_event, index),
+                                    AMotionEvent_getY         (android_event, index),
+                                    AMotionEvent_getPointerId (android_event, index),
+                                    AMotionEvent_getEventTime (android_event)
+                                )
+                            );
 
                             break;
                         }
@@ -11,20 +11,32 @@
 #ifndef BASICS_ACCELEROMETER_HEADER
 #define BASICS_ACCELEROMETER_HEADER
 
+    #include <cstdint>
+    #include <basics/Seqlock>
+
     namespace basics
     {
 
+        /**
+         * El hilo de los sensores escribe las muestras y el de la escena las lee sin bloquearse:
+         * get_state() retorna siempre una muestra completa (nunca con unos ejes de una lectura y
+         * otros de la siguiente) y get_history() las últimas muestras con su tiempo para poder
+         * filtrarlas.
+         */
         class Accelerometer
         {
         public:
 
             struct State
             {
-                float x;
-                float y;
-                float z;
+                float   x;
+                float   y;
+                float   z;
+                int64_t time;                               ///< Nanosegundos (reloj de los eventos).
             };
 
+            static constexpr size_t history_capacity = 64;
+
         public:
 
             static bool            is_available ();
@@ -32,23 +44,58 @@
 
         protected:
 
-            State state;
+            Seqlock< State >                         state;
+            Seqlock_Ring< State, history_capacity >  history;
+            float                                    sampling_rate = 50.f;
 
         public:
 
-            const State & get_state ()
+            State get_state () const
+            {
+                return state.load ();
+            }
+
+            /**
+             * Copia en samples las últimas muestras (como mucho max_count), de la más antigua a la
+             * más reciente, y retorna cuántas ha copiado.
+             */
+            size_t get_history (State * samples, size_t max_count) const
+            {
+                return history.read_latest (samples, max_count);
+            }
+
+            /**
+             * Cantidad de muestras recibidas desde que se creó el acelerómetro.
+             */
+            uint64_t get_sample_count () const
+            {
+                return history.get_written_count ();
+            }
+
+            /**
+             * La usa el hilo de los sensores y puede servir para simular ciertos comportamientos del
+             * acelerómetro. Solo debe llamarla un hilo.
+             */
+            void set_state (float new_x, float new_y, float new_z, int64_t time = 0)
+            {
+                State new_state = { new_x, new_y, new_z, time };
+
+                state  .store (new_state);
+                history.push  (new_state);
+            }
+
+            float get_sampling_rate () const
             {
-                return state;
+                return sampling_rate;
             }
 
             /**
-             * Puede servir para simular ciertos comportamientos del acelerómetro.
+             * Muestras por segundo que se piden al sensor (50 por defecto). El sistema lo toma como
+             * una sugerencia.
              */
-            void set_state (float new_x, float new_y, float new_z)
+            virtual bool set_sampling_rate (float samples_per_second)
             {
-                state.x = new_x;
-                state.y = new_y;
-                state.z = new_z;
+                return samples_per_second > 0.f ? sampling_rate = samples_per_second, true : false;
             }
 
         public:
@@ -49,7 +49,10 @@
 
         protected:
 
-            Event_Queue event_queue;
+            // Los eventos del ciclo de vida no se pueden perder, así que si la cola se llena el
+            // hilo que los envía espera:
+
+            Event_Queue event_queue{ 64, Event_Queue::WAIT };
 
         protected:
 
@@ -69,7 +72,7 @@
 
             void push (Event && event)
             {
-                event_queue.push (event);
+                event_queue.push (std::move (event));
             }
 
             bool poll (Event & event)
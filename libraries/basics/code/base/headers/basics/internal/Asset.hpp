@@ -32,12 +32,45 @@
                 END
             };
 
+            /**
+             * Indica al sistema cómo se van a leer los datos de map() para que ajuste la lectura
+             * anticipada. Con SEQUENTIAL además se pide que empiece a cargarlos de inmediato.
+             */
+            enum Access
+            {
+                SEQUENTIAL,
+                RANDOM
+            };
+
+            /**
+             * Vista de solo lectura del contenido de un asset. No es propietaria de los datos, que
+             * solo son válidos mientras el asset del que procede siga abierto.
+             */
+            struct View
+            {
+                const byte * data;
+                size_t       size;
+
+                const byte * begin () const { return data;        }
+                const byte * end   () const { return data + size; }
+                bool         empty () const { return size == 0;   }
+            };
+
         public:
 
+            /**
+             * Busca la ruta en el paquete de assets por defecto (ver Asset_Pack) y, si no está en
+             * él, abre el archivo suelto. Devuelve nullptr si no existe en ninguno de los dos.
+             */
             static std::shared_ptr< Asset > open (const std::string & path);
             static bool exists (const std::string & path);
             static size_t size (const std::string & path);
 
+            /**
+             * Abre un archivo suelto sin buscarlo en el paquete de assets.
+             */
+            static std::shared_ptr< Asset > open_file (const std::string & path);
+
         protected:
 
             Asset() = default;
@@ -55,9 +88,23 @@
             virtual bool   seek (ptrdiff_t offset, Anchor = CURRENT) = 0;
             virtual size_t tell () const = 0;
             virtual byte   read () = 0;
+
+            /**
+             * Lee como mucho size bytes a partir de la posición actual.
+             * @return Cantidad de bytes leídos. Es menor que size al llegar al final (y entonces
+             *     eof() pasa a true) o si se produce un error (y fail() pasa a true).
+             */
+            virtual size_t read_some (byte * buffer, size_t size) = 0;
             virtual bool   read_all (std::vector< byte > & buffer) = 0;
             virtual bool   read_all (std::string & buffer) = 0;
 
+            /**
+             * Da acceso directo al contenido completo sin copiarlo (proyectándolo en memoria
+             * cuando es posible). Si falla, devuelve una vista nula y el asset pasa a fail().
+             * Llamadas sucesivas devuelven la misma vista.
+             */
+            virtual View   map (Access access = SEQUENTIAL) = 0;
+
         };
 
     }
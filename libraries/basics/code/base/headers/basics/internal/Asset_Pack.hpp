@@ -0,0 +1,123 @@
+/*
+ * ASSET PACK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181610
+ */
+
+#ifndef BASICS_ASSET_PACK_HEADER
+#define BASICS_ASSET_PACK_HEADER
+
+    #include <memory>
+    #include <string>
+    #include <basics/Asset>
+    #include <basics/fnv>
+    #include <basics/Id>
+
+    namespace basics
+    {
+
+        /**
+         * Archivo que agrupa muchos assets para abrirlos todos con una sola proyección en memoria.
+         *
+         * Empieza con una cabecera seguida de una tabla hash (direccionamiento abierto con sondeo
+         * lineal y un número de huecos potencia de 2) indexada por el FNV-1a de 32 bits de la ruta
+         * de cada asset, que es el mismo valor que da ID() con la ruta literal. Tras la tabla van
+         * las rutas (terminadas en un caracter nulo) y luego los contenidos, guardados tal cual o
+         * comprimidos con LZ4. Cada contenido empieza en un múltiplo de 16 bytes desde el inicio
+         * del archivo. Todos los enteros son little endian.
+         *
+         * Asset::open() busca primero en el paquete por defecto y, si la ruta no está en él, abre
+         * el archivo suelto. Para que el paquete se pueda proyectar en memoria no debe estar
+         * comprimido dentro del APK (noCompress 'pak' en build.gradle).
+         */
+        class Asset_Pack
+        {
+        public:
+
+            static const uint32_t   magic     = 0x4B415042;     ///< "BPAK".
+            static const uint32_t   version   = 1;
+            static const uint32_t   alignment = 16;
+            static const char     * default_path;               ///< "assets.pak".
+
+            enum Compression
+            {
+                STORED,
+                LZ4
+            };
+
+            struct Header
+            {
+                uint32_t magic;
+                uint32_t version;
+                uint32_t entry_count;
+                uint32_t slot_count;                            ///< Los huecos libres tienen offset 0.
+            };
+
+            struct Entry
+            {
+                uint32_t id;
+                uint32_t path_offset;
+                uint32_t offset;
+                uint32_t stored_size;
+                uint32_t size;
+                uint32_t compression;
+            };
+
+        public:
+
+            /**
+             * Devuelve el paquete que se encuentra en default_path. Se intenta abrir la primera
+             * vez que se llama. Si no existe, devuelve nullptr.
+             */
+            static const Asset_Pack * get_default ();
+
+            static Id get_id (const std::string & path)
+            {
+                return fnv32 (path);
+            }
+
+        private:
+
+            std::shared_ptr< Asset > file;
+            Asset::View              data;
+            const Entry            * slots;
+            uint32_t                 slot_count;
+
+        public:
+
+            /**
+             * Comprueba la cabecera y la tabla del archivo y lo proyecta en memoria, que queda así
+             * compartida por todas las entradas.
+             */
+            explicit Asset_Pack(const std::shared_ptr< Asset > & file);
+
+            bool good () const
+            {
+                return slots != nullptr;
+            }
+
+            /**
+             * Busca una entrada por su id. Si hay colisiones entre rutas sueltas y rutas del
+             * paquete solo se distinguen con la versión que recibe la ruta.
+             */
+            const Entry * find (Id id) const;
+
+            const Entry * find (const std::string & path) const;
+
+            /**
+             * Devuelve un asset que lee de la memoria del paquete. Las entradas guardadas tal cual
+             * no se copian. Las comprimidas se descomprimen en este momento.
+             */
+            std::shared_ptr< Asset > open (const Entry & entry) const;
+
+        };
+
+    }
+
+#endif
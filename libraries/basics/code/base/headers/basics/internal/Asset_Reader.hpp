@@ -0,0 +1,83 @@
+/*
+ * ASSET READER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181640
+ */
+
+#ifndef BASICS_ASSET_READER_HEADER
+#define BASICS_ASSET_READER_HEADER
+
+    #include <future>
+    #include <string>
+    #include <vector>
+    #include <functional>
+    #include <basics/Asset>
+    #include <basics/Non_Instantiable>
+
+    namespace basics
+    {
+
+        /**
+         * Lee assets en un hilo de entrada/salida dedicado para que la espera por el almacenamiento
+         * se solape con el trabajo del hilo que los usa (por ejemplo, decodificar la textura
+         * anterior). Las lecturas se atienden en el orden en que se piden.
+         */
+        class Asset_Reader : Non_Instantiable
+        {
+        public:
+
+            /**
+             * Asset abierto junto con su contenido completo (ver Asset::map()), que ya está en
+             * memoria cuando se entrega. La vista es válida mientras se conserve el asset.
+             */
+            struct Result
+            {
+                std::shared_ptr< Asset > asset;
+                Asset::View              data;
+
+                bool good () const
+                {
+                    return asset != nullptr;
+                }
+            };
+
+            typedef std::function< void (Result & result) > Callback;
+
+        public:
+
+            static std::shared_future< Result > read_async (const std::string & path);
+
+            /**
+             * El callback se ejecuta en el hilo de entrada/salida, por lo que debe ser breve y
+             * ocuparse él mismo de la sincronización con otros hilos.
+             */
+            static void read_async (const std::string & path, const Callback & callback);
+
+            /**
+             * Bloquea hasta que la lectura termina. Si la ruta se había precargado y aún no se ha
+             * consumido se usa ese resultado.
+             */
+            static Result read (const std::string & path)
+            {
+                return read_async (path).get ();
+            }
+
+            /**
+             * Encola la lectura de varias rutas. Cada resultado se conserva hasta que se pide esa
+             * misma ruta con read() o read_async() o hasta que se llama a discard_prefetched().
+             */
+            static void prefetch (const std::vector< std::string > & paths);
+
+            static void discard_prefetched ();
+
+        };
+
+    }
+
+#endif
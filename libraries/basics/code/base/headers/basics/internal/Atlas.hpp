@@ -17,11 +17,12 @@
     #include <memory>
     #include <string>
     #include <vector>
-    #include <rapidxml.hpp>
+    #include <basics/cooked>
     #include <basics/Id>
     #include <basics/Point>
     #include <basics/Size>
     #include <basics/Texture_2D>
+    #include <basics/Texture_Manager>
     #include <basics/Graphics_Context>
 
     namespace basics
@@ -55,7 +56,11 @@
 
         public:
 
-            Atlas(const std::string    & path, Graphics_Context::Accessor & context);
+            /**
+             * Si se indica un gestor de texturas, la textura del atlas se pide a él para que se
+             * comparta con otras escenas.
+             */
+            Atlas(const std::string    & path, Graphics_Context::Accessor & context, Texture_Manager * texture_manager = nullptr);
             Atlas(const Texture_Handle & texture);
 
         public:
@@ -93,10 +98,13 @@
 
         private:
 
-            void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor & context);
-            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context);
-            void parse_dir (rapidxml::xml_node<> * dir_tag, const std::string & prefix = std::string());
-            void parse_spr (rapidxml::xml_node<> * spr_tag, const std::string & id);
+            void load
+            (
+                const cooked::Atlas_Data   & atlas_data,
+                const std::string          & path,
+                Graphics_Context::Accessor & context,
+                Texture_Manager            * texture_manager
+            );
 
         };
 
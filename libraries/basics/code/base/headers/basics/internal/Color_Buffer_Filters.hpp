@@ -0,0 +1,66 @@
+/*
+ * COLOR BUFFER FILTERS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181500
+ */
+
+#ifndef BASICS_COLOR_BUFFER_FILTERS_HEADER
+#define BASICS_COLOR_BUFFER_FILTERS_HEADER
+
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Multiplica el color de cada pixel por su alfa (redondeando a 8 bits).
+         */
+        void premultiply_alpha (Color_Buffer< Rgba8888 > & color_buffer);
+
+        /**
+         * Operación inversa de premultiply_alpha(). Los pixels con alfa 0 quedan en negro.
+         */
+        void unpremultiply_alpha (Color_Buffer< Rgba8888 > & color_buffer);
+
+        /**
+         * Reduce la imagen a la mitad en cada dimensión (sin bajar de 1) promediando bloques de
+         * 2x2 pixels. Si alguna dimensión es impar se repite la última fila o columna. Para que
+         * el resultado sea correcto con transparencias la imagen debe estar premultiplicada.
+         */
+        void downsample (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba8888 > & destination);
+
+        /**
+         * Calcula el menor rectángulo (con la fila 0 arriba) que contiene todos los pixels con
+         * alfa distinto de 0. Devuelve false si la imagen es completamente transparente.
+         */
+        bool find_visible_bounds
+        (
+            const Color_Buffer< Rgba8888 > & color_buffer,
+            unsigned & left,
+            unsigned & top,
+            unsigned & width,
+            unsigned & height
+        );
+
+        /**
+         * Copia en destination el rectángulo de source indicado, que debe estar dentro de él.
+         */
+        void crop
+        (
+            const Color_Buffer< Rgba8888 > & source,
+            unsigned left,
+            unsigned top,
+            unsigned width,
+            unsigned height,
+            Color_Buffer< Rgba8888 > & destination
+        );
+
+    }
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * COMPRESSED BUFFER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181130
+ */
+
+#ifndef BASICS_COMPRESSED_BUFFER_HEADER
+#define BASICS_COMPRESSED_BUFFER_HEADER
+
+    #include <vector>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Guarda una imagen codificada en bloques de 4x4 texels tal y como la espera la GPU.
+         * Las dimensiones son las de la imagen original. Los bloques cubren las dimensiones
+         * redondeadas al siguiente múltiplo de 4 y se almacenan por filas empezando por arriba.
+         */
+        class Compressed_Buffer
+        {
+        public:
+
+            enum Format
+            {
+                ETC1_RGB8,                          ///< ETC1: 8 bytes por bloque, sin alfa.
+                ETC2_RGB8,                          ///< ETC2: 8 bytes por bloque, sin alfa (compatible con ETC1).
+                ETC2_RGBA8,                         ///< ETC2 + EAC: 16 bytes por bloque (alfa en los 8 primeros).
+            };
+
+            typedef std::vector< byte > Buffer;
+
+        public:
+
+            Format   format;
+            unsigned width;
+            unsigned height;
+            Buffer   blocks;
+
+        public:
+
+            Compressed_Buffer()
+            :
+                format(ETC1_RGB8),
+                width (0),
+                height(0)
+            {
+            }
+
+            Compressed_Buffer(Format format, unsigned width, unsigned height)
+            :
+                format(format),
+                width (width ),
+                height(height),
+                blocks(get_block_size (format) * ((width + 3) / 4) * ((height + 3) / 4))
+            {
+            }
+
+        public:
+
+            static unsigned get_block_size (Format format)
+            {
+                return format == ETC2_RGBA8 ? 16 : 8;
+            }
+
+            unsigned get_block_size () const
+            {
+                return get_block_size (format);
+            }
+
+            unsigned get_blocks_per_row () const
+            {
+                return (width + 3) / 4;
+            }
+
+            unsigned get_blocks_per_column () const
+            {
+                return (height + 3) / 4;
+            }
+
+            size_t size () const
+            {
+                return blocks.size ();
+            }
+
+            bool has_alpha () const
+            {
+                return format == ETC2_RGBA8;
+            }
+
+        public:
+
+            byte * get_block (unsigned block_x, unsigned block_y)
+            {
+                return blocks.data () + (block_y * get_blocks_per_row () + block_x) * get_block_size ();
+            }
+
+            const byte * get_block (unsigned block_x, unsigned block_y) const
+            {
+                return blocks.data () + (block_y * get_blocks_per_row () + block_x) * get_block_size ();
+            }
+
+        };
+
+    }
+
+#endif
@@ -14,6 +14,7 @@
 #define BASICS_EVENT_HEADER
 
     #include <map>
+    #include <cstdint>
     #include <basics/fnv>
     #include <basics/Id>
     #include <basics/Var>
@@ -21,24 +22,121 @@
     namespace basics
     {
 
+        /**
+         * Los datos de los eventos más frecuentes (toques, teclas y sensores) se guardan en campos
+         * dentro del propio evento, de modo que crearlos, pasarlos por la cola y leerlos no
+         * reserva memoria. La lista de propiedades solo se usa en eventos que necesitan datos
+         * adicionales: mientras está vacía tampoco reserva memoria.
+         */
         struct Event
         {
         public:
 
-            typedef std::map< Id, Var > Property_List;      // REEMPLAZAR POR UN MAPA "LIGERO"
+            typedef std::map< Id, Var > Property_List;
+
+            /**
+             * Indica cuál de los campos de la unión es válido.
+             */
+            enum Kind : uint8_t
+            {
+                GENERIC,                            ///< Sin datos (ciclo de vida, ventana, etc.) o con propiedades.
+                TOUCH,
+                KEY,
+                SENSOR,
+            };
+
+            /**
+             * Posición anterior de un puntero. El tiempo está en nanosegundos (el reloj depende de
+             * la plataforma y solo tiene sentido comparar tiempos entre sí).
+             */
+            struct Touch_Sample
+            {
+                float   x;
+                float   y;
+                int64_t time;
+            };
+
+            /**
+             * Los eventos touch-moved se agrupan por fotograma (ver Touch_Coalescer): llevan la
+             * última posición del puntero y en history las posiciones intermedias, de la más antigua
+             * a la más reciente. history solo es válido mientras se atiende el evento.
+             */
+            struct Touch
+            {
+                float          x;
+                float          y;
+                int32_t        pointer_id;
+                uint32_t       history_size;
+                int64_t        time;
+                Touch_Sample * history;
+            };
+
+            struct Key
+            {
+                int32_t code;
+                int32_t action;
+            };
+
+            struct Sensor
+            {
+                float x;
+                float y;
+                float z;
+            };
 
         public:
 
             Id            id;
             int           priority;
+            Kind          kind;
+
+            union
+            {
+                Touch     touch;
+                Key       key;
+                Sensor    sensor;
+            };
+
             Property_List properties;
 
         public:
 
-            Event(Id id = 0) : id(id), priority(0)
+            Event(Id id = 0) : id(id), priority(0), kind(GENERIC), touch()
+            {
+            }
+
+            static Event make_touch (Id id, float x, float y, int32_t pointer_id, int64_t time = 0)
+            {
+                Event event(id);
+
+                event.kind  = TOUCH;
+                event.touch = { x, y, pointer_id, 0, time, nullptr };
+
+                return event;
+            }
+
+            static Event make_key (Id id, int32_t code, int32_t action)
             {
+                Event event(id);
+
+                event.kind = KEY;
+                event.key  = { code, action };
+
+                return event;
             }
 
+            static Event make_sensor (Id id, float x, float y, float z)
+            {
+                Event event(id);
+
+                event.kind   = SENSOR;
+                event.sensor = { x, y, z };
+
+                return event;
+            }
+
+        public:
+
             Var & operator [] (const Id & id)
             {
                 return properties[id];
@@ -13,68 +13,220 @@
 #ifndef BASICS_EVENT_QUEUE_HEADER
 #define BASICS_EVENT_QUEUE_HEADER
 
-    #include <queue>
-    #include <mutex>
+    #include <atomic>
+    #include <memory>
+    #include <thread>
+    #include <cstddef>
+    #include <cstdint>
     #include <basics/Event>
+    #include <basics/Non_Copyable>
 
     namespace basics
     {
 
-        class Event_Queue
+        /**
+         * Cola de eventos acotada y sin bloqueos para varios productores y un solo consumidor.
+         * Los eventos se guardan en un anillo de slots reservados de antemano. Cada slot tiene un
+         * número de secuencia que indica si está libre o si ya contiene el evento de esa vuelta,
+         * por lo que los productores solo compiten por el índice de escritura (con un CAS) y el
+         * consumidor no compite con nadie.
+         * push() se puede llamar desde cualquier hilo, pero poll(), peek(), drain() y clear()
+         * solo desde el hilo que consume los eventos.
+         */
+        class Event_Queue : Non_Copyable
         {
+        public:
+
+            /**
+             * Qué hace push() cuando la cola está llena.
+             */
+            enum Overflow_Policy
+            {
+                DROP_NEWEST,                        ///< Descarta el evento nuevo y retorna false.
+                WAIT,                               ///< Espera a que el consumidor libere un slot.
+            };
+
+            static constexpr size_t default_capacity = 256;
+
+        private:
+
+            static constexpr size_t cache_line_size = 64;
 
-            std::queue< Event > queue;
-            std::mutex          mutex;
+            struct Slot
+            {
+                std::atomic< size_t > sequence;
+                Event                 event;
+            };
+
+            // Los índices de los productores y del consumidor están en líneas de caché distintas
+            // para que no se invaliden mutuamente:
+
+            std::unique_ptr< Slot[] > slots;
+            size_t                    mask;
+            Overflow_Policy           overflow_policy;
+            std::atomic< size_t >     dropped;
+            char                      padding_0[cache_line_size];
+            std::atomic< size_t >     tail;         ///< Siguiente posición que ocupará un productor.
+            char                      padding_1[cache_line_size - sizeof(std::atomic< size_t >)];
+            size_t                    head;         ///< Siguiente posición que leerá el consumidor.
 
         public:
 
-            void clear ()
+            /**
+             * La capacidad se redondea a la siguiente potencia de 2.
+             */
+            Event_Queue(size_t capacity = default_capacity, Overflow_Policy overflow_policy = DROP_NEWEST)
+            :
+                overflow_policy(overflow_policy)
             {
-                std::queue< Event >().swap (queue);
+                size_t size = 2;
+
+                while (size < capacity) size <<= 1;
+
+                slots.reset (new Slot[size]);
+                mask = size - 1;
+
+                for (size_t index = 0; index < size; ++index)
+                {
+                    slots[index].sequence.store (index, std::memory_order_relaxed);
+                }
+
+                dropped.store (0, std::memory_order_relaxed);
+                tail   .store (0, std::memory_order_relaxed);
+                head = 0;
             }
 
-            void push (const Event & event)
+        public:
+
+            void clear ()
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                drain ([] (Event & ) { });
+            }
 
-                queue.push (event);
+            bool push (const Event & event)
+            {
+                return push (Event(event));
             }
 
-            void push (Event && event)
+            bool push (Event && event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                size_t position = tail.load (std::memory_order_relaxed);
 
-                queue.push (event);
+                for (;;)
+                {
+                    Slot    & slot       = slots[position & mask];
+                    size_t    sequence   = slot.sequence.load (std::memory_order_acquire);
+                    ptrdiff_t difference = ptrdiff_t(sequence - position);
+
+                    if (difference == 0)
+                    {
+                        // El slot está libre en esta vuelta. Si otro productor se adelanta, el CAS
+                        // falla y actualiza position:
+
+                        if (tail.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                        {
+                            slot.event = std::move (event);
+                            slot.sequence.store (position + 1, std::memory_order_release);
+
+                            return true;
+                        }
+                    }
+                    else
+                    if (difference < 0)
+                    {
+                        // El consumidor todavía no ha leído el evento de la vuelta anterior:
+
+                        if (overflow_policy == DROP_NEWEST)
+                        {
+                            dropped.fetch_add (1, std::memory_order_relaxed);
+
+                            return false;
+                        }
+
+                        std::this_thread::yield ();
+
+                        position = tail.load (std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        position = tail.load (std::memory_order_relaxed);
+                    }
+                }
             }
 
             bool poll (Event & event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                Slot & slot = slots[head & mask];
 
-                if (queue.size () > 0)
-                {
-                    event = queue.front ();
+                if (slot.sequence.load (std::memory_order_acquire) != head + 1) return false;
 
-                    queue.pop ();
+                event = std::move (slot.event);
 
-                    return true;
-                }
+                release (slot);
 
-                return false;
+                return true;
             }
 
             bool peek (Event & event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                Slot & slot = slots[head & mask];
 
-                if (queue.size () > 0)
+                if (slot.sequence.load (std::memory_order_acquire) != head + 1) return false;
+
+                event = slot.event;
+
+                return true;
+            }
+
+            /**
+             * Pasa al handler, sin copiarlos, los eventos que hay en la cola (como mucho
+             * max_count) y retorna cuántos eran. El handler no debe volver a llamar a drain()
+             * ni a poll().
+             */
+            template< class HANDLER >
+            size_t drain (HANDLER && handler, size_t max_count = SIZE_MAX)
+            {
+                size_t count = 0;
+
+                for ( ; count < max_count; ++count)
                 {
-                    event = queue.front ();
+                    Slot & slot = slots[head & mask];
 
-                    return true;
+                    if (slot.sequence.load (std::memory_order_acquire) != head + 1) break;
+
+                    handler (slot.event);
+
+                    release (slot);
                 }
 
-                return false;
+                return count;
+            }
+
+        public:
+
+            size_t capacity () const
+            {
+                return mask + 1;
+            }
+
+            /**
+             * Cantidad de eventos que se han descartado por encontrar la cola llena.
+             */
+            size_t get_dropped_count () const
+            {
+                return dropped.load (std::memory_order_relaxed);
+            }
+
+        private:
+
+            void release (Slot & slot)
+            {
+                // Se liberan las propiedades del evento antes de devolver el slot a los productores:
+
+                slot.event = Event();
+                slot.sequence.store (head + mask + 1, std::memory_order_release);
+
+                head++;
             }
 
         };
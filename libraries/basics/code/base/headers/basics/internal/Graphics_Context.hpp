@@ -13,19 +13,21 @@
 #ifndef BASICS_GRAPHICS_CONTEXT_HEADER
 #define BASICS_GRAPHICS_CONTEXT_HEADER
 
-    #include <map>
+    #include <algorithm>
     #include <memory>
     #include <mutex>
     #include <utility>
-    #include <vector>
 
     #include <basics/assert>
     #include <basics/declarations>
     #include <basics/Graphics_Resource_Cache>
     #include <basics/Id>
     #include <basics/Point>
+    #include <basics/Slot_Map>
     #include <basics/Size>
+    #include <basics/Tiny_Map>
     #include <basics/types>
+    #include <basics/Upload_Queue>
 
     namespace basics
     {
@@ -126,21 +128,24 @@
 
         private:
 
-            typedef std::map< Id, std::shared_ptr< Renderer > >          Renderer_List;
-            typedef std::vector<  std::shared_ptr< Graphics_Resource > > Resource_List;
+            typedef Tiny_Map< Id, std::shared_ptr< Renderer >, 4 >       Renderer_List;
+            typedef Slot_Map< std::weak_ptr< Graphics_Resource > >        Resource_List;
 
         protected:
 
             Window                  & window;
             Renderer_List             renderers;
             Resource_List             resources;
+            size_t                    resources_to_prune;       ///< Tamaño al que se descartan los recursos eliminados.
             Graphics_Resource_Cache * graphics_resource_cache;
+            Upload_Queue              upload_queue;
 
         protected:
 
             Graphics_Context(Window & window, Graphics_Resource_Cache * cache = nullptr)
             :
                 window(window),
+                resources_to_prune(16),
                 graphics_resource_cache(cache)
             {
             }
@@ -152,14 +157,14 @@
             template< class RENDERER >
             RENDERER * get_renderer (Id id)
             {
-                Renderer_List::iterator renderer = renderers.find (id);
+                std::shared_ptr< Renderer > * renderer = renderers.get (id);
 
-                return dynamic_cast< RENDERER * >(renderer != renderers.end () ? renderer->second.get () : nullptr);
+                return dynamic_cast< RENDERER * >(renderer ? renderer->get () : nullptr);
             }
 
             bool add (Id id, const std::shared_ptr< Renderer > & renderer)
             {
-                return renderers.find (id) == renderers.end () ? renderers[id] = renderer, true : false;
+                return renderers.insert (id, renderer).second;
             }
 
             // CUIDADO CON AÑADIR DUPLICADOS. PODRÍA ESTAR BIEN QUE CADA RECURSO TUVIESE UN Id ÚNICO Y
@@ -168,7 +173,7 @@
             {
                 if (resource)
                 {
-                    resources.push_back (resource);
+                    track (resource);
 
                     return resource->initialize ();
                 }
@@ -176,23 +181,136 @@
                 return false;
             }
 
+            /**
+             * Como add(resource), pero la transferencia a la GPU se deja en la cola de subidas,
+             * que la reparte entre los siguientes fotogramas. Mientras tanto el recurso no se
+             * puede usar (los Canvas omiten las texturas que aún no están listas).
+             */
+            bool add (const std::shared_ptr< Graphics_Resource > & resource, Upload_Queue::Priority priority)
+            {
+                if (resource)
+                {
+                    track (resource);
+                    upload_queue.push (resource, priority);
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * Sube el recurso en un hilo de carga con un contexto compartido, si la plataforma lo
+             * admite, para que las llamadas a glTexImage2D() no ocupen el hilo que dibuja. El
+             * recurso no se puede usar hasta que la GPU ha terminado de procesarlo y
+             * process_uploads() lo publica. Si no hay hilo de carga se usa la cola de subidas.
+             */
+            virtual bool add_in_background (const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                return add (resource, Upload_Queue::PRIORITY_NORMAL);
+            }
+
+            Upload_Queue & get_upload_queue ()
+            {
+                return upload_queue;
+            }
+
+            /**
+             * Avanza la cola de subidas según su presupuesto y publica lo que haya terminado el
+             * hilo de carga. Se llama en cada fotograma antes de dibujar.
+             */
+            virtual void process_uploads ()
+            {
+                upload_queue.process ();
+            }
+
+            virtual bool has_pending_uploads () const
+            {
+                return !upload_queue.empty ();
+            }
+
+            size_t get_resource_count () const
+            {
+                return resources.size ();
+            }
+
+            /**
+             * Resumen de los recursos añadidos al contexto que siguen existiendo.
+             */
+            Graphics_Resource_Report get_resource_report () const
+            {
+                Graphics_Resource_Report report;
+
+                for (auto & entry : resources)
+                {
+                    auto resource = entry.lock ();
+
+                    if  (resource) report.add (*resource);
+                }
+
+                return report;
+            }
+
+            Graphics_Resource_Cache * get_resource_cache ()
+            {
+                return graphics_resource_cache;
+            }
+
+        protected:
+
+            /**
+             * El contexto solo observa los recursos (los mantienen vivos las escenas, los atlas,
+             * etc.). Las entradas de los que ya se han eliminado se descartan cada vez que el
+             * número de entradas se duplica, de modo que cambiar de escena no hace crecer la lista
+             * indefinidamente y el coste se reparte entre las llamadas a add().
+             */
+            void track (const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                if (resources.size () >= resources_to_prune)
+                {
+                    resources.remove_if
+                    (
+                        [] (const std::weak_ptr< Graphics_Resource > & entry) { return entry.expired (); }
+                    );
+
+                    resources_to_prune = std::max< size_t > (16, resources.size () * 2);
+                }
+
+                resources.insert (resource);
+            }
+
+            static void set_loading (Graphics_Resource & resource, bool loading)
+            {
+                resource.loading = loading;
+            }
+
         public:
 
+            /**
+             * Los recursos que se deben volver a crear se encolan en lugar de subirse todos en el
+             * mismo fotograma.
+             */
             virtual void initialize ()
             {
                 if (graphics_resource_cache)
                 {
+                    graphics_resource_cache->prune ();
+
                     for (auto iterator = graphics_resource_cache->begin (); iterator != graphics_resource_cache->end (); ++iterator)
                     {
-                        add (iterator->lock ());
+                        add (iterator->lock (), Upload_Queue::PRIORITY_NORMAL);
                     }
                 }
             }
 
             virtual void finalize ()
             {
+                upload_queue.clear ();
+
                 if (graphics_resource_cache)
                 {
+                    graphics_resource_cache->prune ();
+
                     for (auto iterator = graphics_resource_cache->begin (); iterator != graphics_resource_cache->end (); ++iterator)
                     {
                         auto resource = iterator->lock ();
@@ -220,6 +338,12 @@
             virtual bool make_current () = 0;
             virtual bool flush_and_display () = 0;
 
+            /**
+             * Deja el contexto sin asociar al hilo que lo llama para que otro hilo pueda hacer
+             * make_current() (por ejemplo, el hilo de render del Director).
+             */
+            virtual bool release_current () = 0;
+
         };
 
     }
@@ -13,22 +13,32 @@
 #ifndef BASICS_GRAPHICS_RESOURCE_HEADER
 #define BASICS_GRAPHICS_RESOURCE_HEADER
 
+    #include <atomic>
     #include <memory>
+    #include <cstddef>
 
     namespace basics
     {
 
         class Graphics_Resource
         {
+
+            friend class Graphics_Context;
+
         protected:
 
-            bool initialized;
+            std::atomic< bool > initialized;            ///< Puede cambiar en el hilo de carga.
+
+        private:
+
+            bool loading;                               ///< Lo tiene el hilo de carga y no se ha publicado.
 
         protected:
 
             Graphics_Resource()
             {
                 initialized = false;
+                loading     = false;
             }
 
             virtual ~Graphics_Resource() = default;
@@ -38,6 +48,91 @@
             virtual bool initialize (/*Graphics_Context & context*/) = 0;
             virtual void finalize   () = 0;
 
+            /**
+             * Avanza la inicialización transfiriendo a la GPU unos byte_budget bytes como mucho
+             * (en cada llamada se transfiere al menos una unidad, aunque supere el presupuesto).
+             * Retorna true cuando el recurso ha quedado inicializado y false si aún falta o si ha
+             * fallado, lo que se distingue porque uploaded_bytes es 0. Por defecto se inicializa
+             * de una vez.
+             */
+            virtual bool initialize_step (size_t /*byte_budget*/, size_t & uploaded_bytes)
+            {
+                uploaded_bytes = 0;
+
+                return initialize ();
+            }
+
+            /**
+             * Cantidad estimada de bytes que quedan por transferir a la GPU.
+             */
+            virtual size_t get_pending_upload_size () const
+            {
+                return 0;
+            }
+
+            /**
+             * Bytes estimados que el recurso ocupa en la GPU mientras está inicializado.
+             */
+            virtual size_t get_gpu_memory_size () const
+            {
+                return 0;
+            }
+
+            /**
+             * Bytes de memoria de la CPU que ocupa lo que el recurso conserva para poder volver a
+             * subirse a la GPU.
+             */
+            virtual size_t get_cpu_memory_size () const
+            {
+                return 0;
+            }
+
+            /**
+             * Un recurso que se está subiendo en el hilo de carga no se considera inicializado
+             * hasta que la GPU ha terminado de procesarlo y el contexto lo publica.
+             */
+            bool is_initialized () const
+            {
+                return initialized && !loading;
+            }
+
+            bool is_loading () const
+            {
+                return loading;
+            }
+
+        };
+
+        /**
+         * Resumen de un conjunto de recursos para detectar los que siguen vivos cuando ya no
+         * deberían.
+         */
+        struct Graphics_Resource_Report
+        {
+            size_t resources   = 0;
+            size_t initialized = 0;
+            size_t loading     = 0;
+            size_t gpu_bytes   = 0;
+            size_t cpu_bytes   = 0;
+
+            void add (const Graphics_Resource & resource)
+            {
+                resources++;
+
+                // Mientras lo tiene el hilo de carga sus datos pueden estar cambiando, así que solo
+                // se cuenta. Sus tamaños se suman cuando se haya publicado:
+
+                if (resource.is_loading ())
+                {
+                    loading++;
+                    return;
+                }
+
+                if (resource.is_initialized ()) initialized++;
+
+                gpu_bytes += resource.get_gpu_memory_size ();
+                cpu_bytes += resource.get_cpu_memory_size ();
+            }
         };
 
     }
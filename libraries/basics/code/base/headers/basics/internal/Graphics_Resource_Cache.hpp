@@ -13,8 +13,9 @@
 #ifndef BASICS_GRAPHICS_RESOURCE_CACHE_HEADER
 #define BASICS_GRAPHICS_RESOURCE_CACHE_HEADER
 
-    #include <list>
+    #include <memory>
     #include <basics/Graphics_Resource>
+    #include <basics/Slot_Map>
 
     namespace basics
     {
@@ -22,20 +23,59 @@
         /**
          * Mantiene punteros weak a recursos que están en uso en situaciones en las que el contexto
          * gráfico se puede destruir y volver a crear.
+         * Las entradas se guardan contiguas en un Slot_Map, por lo que añadir y quitar cuesta O(1)
+         * y el recorrido solo visita entradas vivas. Las de recursos que ya se han eliminado se
+         * descartan con prune().
          */
         class Graphics_Resource_Cache
         {
 
-            typedef std::list< std::weak_ptr< Graphics_Resource > > Graphics_Resource_List;
+            typedef Slot_Map< std::weak_ptr< Graphics_Resource > > Graphics_Resource_List;
 
         public:
 
-            typedef Graphics_Resource_List::iterator Iterator;
+            typedef Graphics_Resource_List::Handle   Handle;
+            typedef Graphics_Resource_List::Iterator Iterator;
 
-        public:
+        private:
 
             Graphics_Resource_List resources;
 
+        public:
+
+            Handle add (const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                return resource ? resources.insert (resource) : Handle();
+            }
+
+            bool remove (Handle handle)
+            {
+                return resources.remove (handle);
+            }
+
+            std::shared_ptr< Graphics_Resource > get (Handle handle) const
+            {
+                auto resource = resources.get (handle);
+
+                return resource ? resource->lock () : nullptr;
+            }
+
+            /**
+             * Descarta las entradas de los recursos que ya no existen y retorna cuántas había.
+             */
+            size_t prune ()
+            {
+                return resources.remove_if
+                (
+                    [] (const std::weak_ptr< Graphics_Resource > & resource) { return resource.expired (); }
+                );
+            }
+
+            size_t size () const
+            {
+                return resources.size ();
+            }
+
         public:
 
             Iterator begin ()
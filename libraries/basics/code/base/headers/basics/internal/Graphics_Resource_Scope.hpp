@@ -0,0 +1,127 @@
+/*
+ * GRAPHICS RESOURCE SCOPE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181810
+ */
+
+#ifndef BASICS_GRAPHICS_RESOURCE_SCOPE_HEADER
+#define BASICS_GRAPHICS_RESOURCE_SCOPE_HEADER
+
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Graphics_Context>
+    #include <basics/Graphics_Resource_Cache>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Agrupa recursos gráficos que tienen la misma vida (los de una escena, los de un nivel,
+         * etc.). Los recursos que se añaden se suben mediante el contexto y se registran en su
+         * caché para que se restauren si se pierde el contexto. Al llamar a release() o al
+         * destruir el ámbito se liberan los objetos de la GPU y se eliminan las entradas de la
+         * caché, aunque alguien conserve todavía punteros a esos recursos (dejan de ser usables).
+         * release() se debe llamar en el hilo en el que el contexto está activo.
+         */
+        class Graphics_Resource_Scope : Non_Copyable
+        {
+
+            struct Entry
+            {
+                std::shared_ptr< Graphics_Resource > resource;
+                Graphics_Resource_Cache::Handle      cache_handle;
+            };
+
+            typedef std::vector< Entry > Entry_List;
+
+        private:
+
+            std::string               name;
+            Entry_List                entries;
+            Graphics_Resource_Cache * cache;
+
+        public:
+
+            Graphics_Resource_Scope(const std::string & name = std::string())
+            :
+                name (name   ),
+                cache(nullptr)
+            {
+            }
+
+           ~Graphics_Resource_Scope()
+            {
+                release ();
+            }
+
+        public:
+
+            /**
+             * Como Graphics_Context::add(resource).
+             */
+            bool add (Graphics_Context::Accessor & context, const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                return keep (context, resource) && context->add (resource);
+            }
+
+            /**
+             * Como Graphics_Context::add(resource, priority).
+             */
+            bool add (Graphics_Context::Accessor & context, const std::shared_ptr< Graphics_Resource > & resource, Upload_Queue::Priority priority)
+            {
+                return keep (context, resource) && context->add (resource, priority);
+            }
+
+            /**
+             * Como Graphics_Context::add_in_background(resource).
+             */
+            bool add_in_background (Graphics_Context::Accessor & context, const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                return keep (context, resource) && context->add_in_background (resource);
+            }
+
+            /**
+             * Incluye en el ámbito un recurso que ya se ha añadido al contexto (por ejemplo, la
+             * textura que crea un Atlas o un Raster_Font).
+             */
+            bool keep (Graphics_Context::Accessor & context, const std::shared_ptr< Graphics_Resource > & resource);
+
+            /**
+             * Finaliza todos los recursos del ámbito y lo deja vacío.
+             */
+            void release ();
+
+        public:
+
+            const std::string & get_name () const
+            {
+                return name;
+            }
+
+            size_t size () const
+            {
+                return entries.size ();
+            }
+
+            Graphics_Resource_Report get_report () const
+            {
+                Graphics_Resource_Report report;
+
+                for (auto & entry : entries) report.add (*entry.resource);
+
+                return report;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,263 @@
+/*
+ * JOB SYSTEM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181900
+ */
+
+#ifndef BASICS_JOB_SYSTEM_HEADER
+#define BASICS_JOB_SYSTEM_HEADER
+
+    #include <atomic>
+    #include <thread>
+    #include <vector>
+    #include <memory>
+    #include <mutex>
+    #include <cstddef>
+    #include <cstdint>
+    #include <utility>
+    #include <type_traits>
+    #include <condition_variable>
+    #include <basics/assert>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Ejecuta trabajos (funciones sin parámetros) en paralelo usando un hilo por núcleo.
+         *
+         * Cada hilo (lane) tiene su propia cola doble: mete y saca trabajos por un extremo sin
+         * competir con nadie y, cuando se queda sin trabajo, roba por el otro extremo de las colas
+         * de los demás. El hilo que crea el Job_System es el lane 0 y ayuda a ejecutar trabajos
+         * mientras espera en wait(). Solo ese hilo y los trabajos pueden crear y lanzar trabajos.
+         *
+         * Un trabajo puede tener un padre: el padre no se da por terminado hasta que terminan todos
+         * sus hijos, así que basta con esperar al padre.
+         *
+         * Los trabajos se guardan en un anillo por lane reservado al construir, de modo que no se
+         * reserva memoria al crearlos. Los huecos cuyo trabajo no ha terminado no se reutilizan: si
+         * un lane tiene jobs_per_lane trabajos sin terminar, create() ejecuta trabajos pendientes
+         * hasta que se libera alguno. Un trabajo que se crea y nunca se lanza ocupa su hueco para
+         * siempre.
+         */
+        class Job_System : Non_Copyable
+        {
+        public:
+
+            static constexpr size_t cache_line_size = 64;
+            static constexpr size_t jobs_per_lane   = 1024;        ///< Potencia de 2.
+
+            /**
+             * Ocupa dos líneas de caché (128 bytes).
+             */
+            struct Job
+            {
+                static constexpr size_t storage_size = 2 * cache_line_size - 4 * sizeof(void *);    ///< 96 o 112 bytes.
+
+                void                 (* function) (Job &);         ///< Ejecuta y destruye lo que hay en storage.
+                Job                   * parent;
+                std::atomic< int32_t >  unfinished;                ///< El propio trabajo más sus hijos sin terminar.
+
+                alignas(std::max_align_t) unsigned char storage[storage_size];
+            };
+
+        private:
+
+            /**
+             * Cola doble de Chase y Lev (con el orden de memoria de Lê et al., 2013) de capacidad fija.
+             * push() y pop() solo los llama su dueño. steal() cualquiera.
+             */
+            class Deque
+            {
+                // Los lanes se reservan con new, que en C++11 no respeta alineamientos mayores que
+                // el de max_align_t, así que los índices se separan con relleno en lugar de alignas:
+
+                std::atomic< int64_t > top;
+                char                   top_padding   [cache_line_size - sizeof(std::atomic< int64_t >)];
+                std::atomic< int64_t > bottom;
+                char                   bottom_padding[cache_line_size - sizeof(std::atomic< int64_t >)];
+                std::atomic< Job *   > jobs[jobs_per_lane];
+
+            public:
+
+                Deque() : top(0), bottom(0)
+                {
+                    for (auto & job : jobs) job.store (nullptr, std::memory_order_relaxed);
+                }
+
+                bool  push  (Job * job);
+                Job * pop   ();
+                Job * steal ();
+
+            };
+
+            struct Lane
+            {
+                Deque    deque;
+                Job      jobs[jobs_per_lane];
+                uint32_t next_job   = 0;
+                uint32_t next_steal = 0;                    ///< Lane al que intentar robar primero.
+
+                Lane()
+                {
+                    for (auto & job : jobs) job.unfinished.store (0, std::memory_order_relaxed);
+                }
+            };
+
+        private:
+
+            std::vector< std::unique_ptr< Lane > > lanes;
+            std::vector< std::thread             > workers;
+
+            std::atomic< bool     > stopping;
+            std::atomic< uint64_t > epoch;                  ///< Cambia cada vez que se lanza un trabajo.
+            std::atomic< int      > sleeping;
+            std::mutex              mutex;
+            std::condition_variable wake_up;
+
+        public:
+
+            /**
+             * @param lane_count Número de hilos que ejecutan trabajos (incluido el que lo construye).
+             *     Con 0 se usa uno por núcleo.
+             */
+            Job_System(unsigned lane_count = 0);
+
+           ~Job_System();
+
+        public:
+
+            unsigned get_lane_count () const
+            {
+                return unsigned(lanes.size ());
+            }
+
+            /**
+             * Lane del hilo que lo llama en este Job_System, o -1 si no es uno de sus hilos.
+             */
+            int get_current_lane () const;
+
+            /**
+             * Crea un trabajo sin lanzarlo. FUNCTION se copia dentro del trabajo (debe ocupar como
+             * mucho Job::storage_size bytes) y se destruye después de ejecutarlo.
+             */
+            template< typename FUNCTION >
+            Job * create (FUNCTION && function)
+            {
+                return create_child (nullptr, std::forward< FUNCTION > (function));
+            }
+
+            /**
+             * Igual que create(), pero parent no terminará hasta que termine el nuevo trabajo. Hay
+             * que crear los hijos antes de que el padre pueda terminar (desde el propio padre o antes
+             * de lanzarlo).
+             */
+            template< typename FUNCTION >
+            Job * create_child (Job * parent, FUNCTION && function)
+            {
+                typedef typename std::decay< FUNCTION >::type Function;
+
+                static_assert (sizeof (Function) <= Job::storage_size, "the job function doesn't fit into a job");
+                static_assert (alignof(Function) <= alignof(std::max_align_t), "the job function is overaligned");
+
+                Job * job = allocate ();
+
+                new (job->storage) Function(std::forward< FUNCTION > (function));
+
+                job->function = &invoke< Function >;
+                job->parent   = parent;
+
+                job->unfinished.store (1, std::memory_order_relaxed);
+
+                if (parent) parent->unfinished.fetch_add (1, std::memory_order_relaxed);
+
+                return job;
+            }
+
+            /**
+             * Pone el trabajo en la cola del hilo actual para que lo ejecute cualquiera de los hilos.
+             */
+            void run (Job * job);
+
+            /**
+             * Ejecuta otros trabajos hasta que el indicado y todos sus hijos han terminado.
+             */
+            void wait (Job * job);
+
+            bool is_finished (const Job * job) const
+            {
+                return job->unfinished.load (std::memory_order_acquire) == 0;
+            }
+
+            /**
+             * Llama a function (first, last) con trozos de [begin, end) de como mucho grain elementos
+             * en paralelo y retorna cuando se han procesado todos. Los trozos se reparten dividiendo
+             * el rango por la mitad en trabajos que los demás hilos pueden robar.
+             */
+            template< typename FUNCTION >
+            void parallel_for (size_t begin, size_t end, size_t grain, const FUNCTION & function)
+            {
+                if (begin >= end) return;
+
+                Job * root = create ([] () { });
+
+                run  (create_child (root, Range_Job< FUNCTION >{ this, root, &function, begin, end, grain > 0 ? grain : 1 }));
+                run  (root);
+                wait (root);
+            }
+
+        private:
+
+            template< typename FUNCTION >
+            struct Range_Job
+            {
+                Job_System     * system;
+                Job            * root;
+                const FUNCTION * function;
+                size_t           begin;
+                size_t           end;
+                size_t           grain;
+
+                void operator () ()
+                {
+                    // La mitad alta se deja para quien la quiera robar y se sigue con la baja:
+
+                    while (end - begin > grain)
+                    {
+                        size_t middle = begin + (end - begin) / 2;
+
+                        system->run (system->create_child (root, Range_Job{ system, root, function, middle, end, grain }));
+
+                        end = middle;
+                    }
+
+                    (*function) (begin, end);
+                }
+            };
+
+            template< typename FUNCTION >
+            static void invoke (Job & job)
+            {
+                FUNCTION & function = *reinterpret_cast< FUNCTION * >(job.storage);
+
+                function ();
+                function.~FUNCTION ();
+            }
+
+            Job * allocate ();
+            Job * find_job (unsigned lane);
+            void  execute  (Job * job);
+            void  finish   (Job * job);
+            void  work     (unsigned lane);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * LATENCY RECORDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181880
+ */
+
+#ifndef BASICS_LATENCY_RECORDER_HEADER
+#define BASICS_LATENCY_RECORDER_HEADER
+
+    #include <vector>
+    #include <cstdint>
+    #include <cstddef>
+
+    namespace basics
+    {
+
+        /**
+         * Guarda las últimas latencias medidas (por ejemplo, desde que se toca la pantalla hasta que
+         * se presenta el fotograma que lo refleja) y calcula un resumen. No reserva memoria después
+         * de construirse.
+         */
+        class Latency_Recorder
+        {
+        public:
+
+            /**
+             * Valores en milisegundos de las latencias guardadas (como mucho las últimas capacity).
+             */
+            struct Summary
+            {
+                size_t   count;
+                uint64_t total_count;                       ///< Latencias registradas desde el último reset().
+                float    mean;
+                float    median;
+                float    p95;
+                float    max;
+            };
+
+        private:
+
+            std::vector< float > samples;                   ///< Búfer circular.
+            mutable
+            std::vector< float > sorted;
+            size_t               next;
+            uint64_t             total_count;
+
+        public:
+
+            Latency_Recorder(size_t capacity = 256) : samples(capacity), sorted(capacity), next(0), total_count(0)
+            {
+            }
+
+            void record (int64_t latency_in_nanoseconds)
+            {
+                samples[next] = float(latency_in_nanoseconds) * 1e-6f;
+
+                next = (next + 1) % samples.size ();
+
+                total_count++;
+            }
+
+            void reset ()
+            {
+                next        = 0;
+                total_count = 0;
+            }
+
+            Summary get_summary () const;
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * PIXEL FORMAT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181400
+ */
+
+#ifndef BASICS_PIXEL_FORMAT_HEADER
+#define BASICS_PIXEL_FORMAT_HEADER
+
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Formatos en los que se puede guardar una textura sin comprimir. Los formatos de 16 bits
+         * empaquetan las componentes empezando por el bit más significativo (como los espera
+         * OpenGL ES con GL_UNSIGNED_SHORT_5_6_5, GL_UNSIGNED_SHORT_5_5_5_1 y GL_UNSIGNED_SHORT_4_4_4_4).
+         */
+        enum Pixel_Format
+        {
+            PIXEL_FORMAT_AUTOMATIC = 0,             ///< Se elige al cargar analizando la imagen.
+            PIXEL_FORMAT_RGBA8888,
+            PIXEL_FORMAT_RGB565,
+            PIXEL_FORMAT_RGBA5551,
+            PIXEL_FORMAT_RGBA4444,
+        };
+
+        inline unsigned get_bytes_per_pixel (Pixel_Format format)
+        {
+            return format == PIXEL_FORMAT_RGBA8888 || format == PIXEL_FORMAT_AUTOMATIC ? 4 : 2;
+        }
+
+        /**
+         * Elige el formato de menos bits que representa la imagen con una relación señal/ruido de
+         * al menos minimum_psnr decibelios (medida sin tramado). Las imágenes opacas pueden usar
+         * RGB565, las que solo tienen alfa 0 o 255 RGBA5551 y el resto RGBA4444. El color de los
+         * pixels totalmente transparentes no se tiene en cuenta.
+         */
+        Pixel_Format choose_pixel_format (const Color_Buffer< Rgba8888 > & color_buffer, float minimum_psnr = 33.f);
+
+        /**
+         * Convierte a un formato de 16 bits redondeando cada componente o, si dither es true,
+         * aplicando un tramado ordenado (Bayer 4x4) a las componentes de color.
+         */
+        void convert_to_rgb565   (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgb565   > & destination, bool dither = false);
+        void convert_to_rgba5551 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba5551 > & destination, bool dither = false);
+        void convert_to_rgba4444 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba4444 > & destination, bool dither = false);
+
+    }
+
+#endif
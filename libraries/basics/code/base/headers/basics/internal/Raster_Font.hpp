@@ -17,6 +17,7 @@
     #include <unordered_map>
     #include <vector>
     #include <basics/Atlas>
+    #include <basics/cooked>
     #include <basics/Font>
     #include <basics/Vector>
 
@@ -72,13 +73,7 @@
 
         private:
 
-            bool parse        (Buffer & font_data, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_font   (rapidxml::xml_node<> *   font_tag, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_pages  (rapidxml::xml_node<> *  pages_tag, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_info   (rapidxml::xml_node<> *   info_tag);
-            bool parse_common (rapidxml::xml_node<> * common_tag);
-            bool parse_chars  (rapidxml::xml_node<> *  chars_tag);
-            bool parse_char   (rapidxml::xml_node<> *   char_tag);
+            bool load (const cooked::Font_Data & font_data, const std::string & path, Graphics_Context::Accessor & context);
 
         };
 
@@ -0,0 +1,119 @@
+/*
+ * RENDER SNAPSHOT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181920
+ */
+
+#ifndef BASICS_RENDER_SNAPSHOT_HEADER
+#define BASICS_RENDER_SNAPSHOT_HEADER
+
+    #include <vector>
+    #include <cstdint>
+    #include <basics/Canvas>
+    #include <basics/Size>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Copia de lo que hay que dibujar en un fotograma. La rellena el hilo del juego y la
+         * consume el hilo de render sin volver a consultar la escena, de modo que mientras se
+         * dibuja un fotograma ya se puede ir simulando el siguiente.
+         * Las texturas se guardan como punteros: la escena debe mantenerlas vivas hasta que el
+         * Director detiene el hilo de render (como muy tarde antes de llamar a finalize()).
+         * Después del primer fotograma no reserva memoria salvo que crezca el número de sprites.
+         */
+        class Render_Snapshot
+        {
+        public:
+
+            struct Sprite
+            {
+                const Texture_2D * texture;
+                float              x, y;                    ///< Posición del punto de anclaje.
+                float              width, height;           ///< Tamaño ya escalado.
+                int                anchor;
+                float              opacity;
+            };
+
+        public:
+
+            Size2u   canvas_size;                           ///< Resolución virtual del Canvas.
+            bool     clear;                                 ///< true si hay que borrar antes de dibujar.
+            bool     reset_canvas;                          ///< true en el primer fotograma de una escena.
+
+            /**
+             * Tiempos de los toques que refleja el fotograma y momento en el que se presentó. Los
+             * usa el Director para medir la latencia cuando el render va en otro hilo.
+             */
+            std::vector< int64_t > touch_times;
+            int64_t                presented_time;
+
+        private:
+
+            std::vector< Sprite > sprites;
+            float                 opacity;
+
+        public:
+
+            Render_Snapshot()
+            {
+                reset ();
+            }
+
+            /**
+             * Deja la instantánea vacía conservando la memoria reservada.
+             */
+            void reset ()
+            {
+                clear          = true;
+                reset_canvas   = false;
+                presented_time = 0;
+                opacity        = 1.f;
+
+                sprites    .clear ();
+                touch_times.clear ();
+            }
+
+            /**
+             * Opacidad que se aplicará a los sprites que se añadan a continuación.
+             */
+            void set_opacity (float new_opacity)
+            {
+                opacity = new_opacity;
+            }
+
+            void add_sprite (const Texture_2D * texture, const Point2f & position, const Size2f & size, int anchor = CENTER)
+            {
+                if (texture)
+                {
+                    sprites.push_back
+                    (
+                        Sprite{ texture, position[0], position[1], size.width, size.height, anchor, opacity }
+                    );
+                }
+            }
+
+            const std::vector< Sprite > & get_sprites () const
+            {
+                return sprites;
+            }
+
+            /**
+             * Dibuja el contenido con el Canvas indicado. Solo se debe llamar desde el hilo que
+             * tiene el contexto gráfico.
+             */
+            void replay (Canvas & canvas) const;
+
+        };
+
+    }
+
+#endif
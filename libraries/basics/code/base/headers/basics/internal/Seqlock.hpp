@@ -0,0 +1,182 @@
+/*
+ * SEQLOCK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181890
+ */
+
+#ifndef BASICS_SEQLOCK_HEADER
+#define BASICS_SEQLOCK_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <cstring>
+    #include <type_traits>
+
+    namespace basics
+    {
+
+        /**
+         * Valor que un solo hilo escribe y otros leen sin bloquearse nunca. El escritor incrementa
+         * el número de secuencia antes y después de escribir (es impar mientras escribe) y los
+         * lectores repiten la lectura si ha cambiado. Los datos se guardan como palabras atómicas
+         * para que la lectura concurrente no sea una carrera en el sentido de C++.
+         *
+         * Solo sirve para tipos pequeños que se puedan copiar con memcpy.
+         */
+        template< typename TYPE >
+        class Seqlock
+        {
+
+            static_assert (std::is_trivially_copyable< TYPE >::value, "Seqlock needs a trivially copyable type");
+
+            static constexpr size_t word_count = (sizeof(TYPE) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+            std::atomic< uint32_t > sequence;
+            std::atomic< uint32_t > words[word_count];
+
+        public:
+
+            Seqlock()
+            {
+                sequence.store (0, std::memory_order_relaxed);
+
+                for (auto & word : words) word.store (0, std::memory_order_relaxed);
+            }
+
+            /**
+             * Solo lo debe llamar el hilo escritor.
+             */
+            void store (const TYPE & value)
+            {
+                uint32_t buffer[word_count] = { };
+
+                std::memcpy (buffer, &value, sizeof(TYPE));
+
+                uint32_t current = sequence.load (std::memory_order_relaxed);
+
+                sequence.store (current + 1, std::memory_order_relaxed);
+
+                std::atomic_thread_fence (std::memory_order_release);
+
+                for (size_t index = 0; index < word_count; ++index)
+                {
+                    words[index].store (buffer[index], std::memory_order_relaxed);
+                }
+
+                sequence.store (current + 2, std::memory_order_release);
+            }
+
+            /**
+             * Retorna una copia completa (nunca a medio escribir) del último valor guardado.
+             */
+            TYPE load () const
+            {
+                uint32_t buffer[word_count];
+                uint32_t before;
+                uint32_t after;
+
+                do
+                {
+                    before = sequence.load (std::memory_order_acquire);
+
+                    for (size_t index = 0; index < word_count; ++index)
+                    {
+                        buffer[index] = words[index].load (std::memory_order_relaxed);
+                    }
+
+                    std::atomic_thread_fence (std::memory_order_acquire);
+
+                    after = sequence.load (std::memory_order_relaxed);
+                }
+                while ((before & 1) != 0 || before != after);
+
+                TYPE value;
+
+                std::memcpy (&value, buffer, sizeof(TYPE));
+
+                return value;
+            }
+
+        };
+
+        /**
+         * Búfer circular de los últimos CAPACITY valores escritos por un solo hilo. El escritor
+         * nunca espera (sobrescribe los más antiguos) y los lectores obtienen copias completas.
+         */
+        template< typename TYPE, size_t CAPACITY >
+        class Seqlock_Ring
+        {
+
+            struct Entry
+            {
+                TYPE     value;
+                uint64_t index;                             ///< Posición en la secuencia de escrituras.
+            };
+
+            Seqlock< Entry >        entries[CAPACITY];
+            std::atomic< uint64_t > written;
+
+        public:
+
+            Seqlock_Ring() : written(0)
+            {
+            }
+
+            static constexpr size_t capacity ()
+            {
+                return CAPACITY;
+            }
+
+            /**
+             * Solo lo debe llamar el hilo escritor.
+             */
+            void push (const TYPE & value)
+            {
+                uint64_t index = written.load (std::memory_order_relaxed);
+
+                entries[index % CAPACITY].store ({ value, index });
+
+                written.store (index + 1, std::memory_order_release);
+            }
+
+            /**
+             * Cantidad de valores escritos desde el principio (no solo los que se conservan).
+             */
+            uint64_t get_written_count () const
+            {
+                return written.load (std::memory_order_acquire);
+            }
+
+            /**
+             * Copia en values los últimos valores (como mucho max_count), del más antiguo al más
+             * reciente, y retorna cuántos ha copiado. Los que el escritor sobrescribe mientras se
+             * leen se omiten.
+             */
+            size_t read_latest (TYPE * values, size_t max_count) const
+            {
+                uint64_t last  = written.load (std::memory_order_acquire);
+                uint64_t count = max_count < CAPACITY ? max_count : CAPACITY;
+                uint64_t first = last > count ? last - count : 0;
+                size_t   read  = 0;
+
+                for (uint64_t index = first; index < last; ++index)
+                {
+                    Entry entry = entries[index % CAPACITY].load ();
+
+                    if (entry.index == index) values[read++] = entry.value;
+                }
+
+                return read;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * SLOT MAP
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181800
+ */
+
+#ifndef BASICS_SLOT_MAP_HEADER
+#define BASICS_SLOT_MAP_HEADER
+
+    #include <vector>
+    #include <cstddef>
+    #include <cstdint>
+    #include <utility>
+    #include <basics/assert>
+
+    namespace basics
+    {
+
+        /**
+         * Contenedor que guarda los valores contiguos en memoria y los identifica mediante
+         * handles estables. Insertar y eliminar cuesta O(1): al eliminar, el último valor ocupa
+         * el hueco y el slot libre se reutiliza más adelante. Cada slot lleva una generación que
+         * se incrementa al liberarlo, por lo que un handle de un valor eliminado deja de ser
+         * válido aunque su slot se haya reutilizado. El recorrido solo visita valores vivos,
+         * pero su orden no se conserva al eliminar.
+         */
+        template< typename VALUE >
+        class Slot_Map
+        {
+        public:
+
+            typedef VALUE Value;
+
+            struct Handle
+            {
+                uint32_t index;
+                uint32_t generation;                ///< 0 en un handle nulo.
+
+                Handle() : index(0), generation(0)
+                {
+                }
+
+                Handle(uint32_t index, uint32_t generation) : index(index), generation(generation)
+                {
+                }
+
+                bool operator == (const Handle & other) const
+                {
+                    return index == other.index && generation == other.generation;
+                }
+
+                bool operator != (const Handle & other) const
+                {
+                    return !(*this == other);
+                }
+
+                operator bool () const
+                {
+                    return generation != 0;
+                }
+            };
+
+            typedef typename std::vector< Value >::iterator       Iterator;
+            typedef typename std::vector< Value >::const_iterator Const_Iterator;
+
+        private:
+
+            static constexpr uint32_t end_of_list = UINT32_MAX;
+
+            struct Slot
+            {
+                uint32_t generation;                ///< Impar mientras el slot está ocupado.
+                uint32_t position;                  ///< Posición del valor o siguiente slot libre.
+            };
+
+            std::vector< Value    > values;
+            std::vector< uint32_t > owners;         ///< Slot de cada valor.
+            std::vector< Slot     > slots;
+            uint32_t                first_free;
+
+        public:
+
+            Slot_Map() : first_free(end_of_list)
+            {
+            }
+
+        public:
+
+            Handle insert (const Value & value)
+            {
+                return emplace (Value(value));
+            }
+
+            Handle emplace (Value && value)
+            {
+                uint32_t index;
+
+                if (first_free != end_of_list)
+                {
+                    index      = first_free;
+                    first_free = slots[index].position;
+                }
+                else
+                {
+                    index = uint32_t(slots.size ());
+
+                    slots.push_back ({ 0, 0 });
+                }
+
+                Slot & slot = slots[index];
+
+                slot.generation++;
+                slot.position = uint32_t(values.size ());
+
+                values.push_back (std::move (value));
+                owners.push_back (index);
+
+                return Handle(index, slot.generation);
+            }
+
+            bool remove (Handle handle)
+            {
+                if (!contains (handle)) return false;
+
+                erase_at (slots[handle.index].position);
+
+                return true;
+            }
+
+            /**
+             * Elimina todos los valores para los que el predicado retorna true.
+             */
+            template< class PREDICATE >
+            size_t remove_if (PREDICATE predicate)
+            {
+                size_t removed = 0;
+
+                // Se recorre desde el final para que el valor que se mueve al hueco ya se haya
+                // comprobado:
+
+                for (size_t position = values.size (); position-- > 0; )
+                {
+                    if (predicate (values[position]))
+                    {
+                        erase_at (uint32_t(position));
+                        removed++;
+                    }
+                }
+
+                return removed;
+            }
+
+            void clear ()
+            {
+                for (uint32_t owner : owners)
+                {
+                    release (owner);
+                }
+
+                values.clear ();
+                owners.clear ();
+            }
+
+        public:
+
+            bool contains (Handle handle) const
+            {
+                return handle && handle.index < slots.size () && slots[handle.index].generation == handle.generation;
+            }
+
+            Value * get (Handle handle)
+            {
+                return contains (handle) ? &values[slots[handle.index].position] : nullptr;
+            }
+
+            const Value * get (Handle handle) const
+            {
+                return contains (handle) ? &values[slots[handle.index].position] : nullptr;
+            }
+
+            size_t size () const
+            {
+                return values.size ();
+            }
+
+            bool empty () const
+            {
+                return values.empty ();
+            }
+
+            Iterator       begin ()       { return values.begin (); }
+            Iterator       end   ()       { return values.end   (); }
+            Const_Iterator begin () const { return values.begin (); }
+            Const_Iterator end   () const { return values.end   (); }
+
+        private:
+
+            void erase_at (uint32_t position)
+            {
+                uint32_t last = uint32_t(values.size () - 1);
+
+                release (owners[position]);
+
+                if (position != last)
+                {
+                    values[position] = std::move (values[last]);
+                    owners[position] = owners[last];
+
+                    slots[owners[position]].position = position;
+                }
+
+                values.pop_back ();
+                owners.pop_back ();
+            }
+
+            void release (uint32_t index)
+            {
+                Slot & slot = slots[index];
+
+                assert(slot.generation & 1);
+
+                // La generación pasa a ser par (libre) y el siguiente uso la vuelve a hacer impar.
+                // Si llegase a dar la vuelta se retira el slot para no repetir handles:
+
+                if (++slot.generation == 0) return;
+
+                slot.position = first_free;
+                first_free    = index;
+            }
+
+        };
+
+    }
+
+#endif
@@ -17,8 +17,10 @@
     #include <string>
     #include <basics/Asset>
     #include <basics/Color_Buffer>
+    #include <basics/Compressed_Buffer>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource>
+    #include <basics/Pixel_Format>
 
     namespace basics
     {
@@ -27,21 +29,71 @@
         {
         public:
 
+            /**
+             * Qué conserva la textura en la memoria de la CPU una vez subida a la GPU para poder
+             * restaurarla si se pierde el contexto gráfico. Con RETAIN_MAPPED_ASSET y
+             * RETAIN_ASSET_PATH la imagen se vuelve a decodificar, lo que solo es posible si la
+             * textura se ha creado a partir de un asset; si no, se usa RETAIN_COMPRESSED.
+             */
+            enum Retention
+            {
+                RETAIN_PIXELS,                      ///< Conserva los niveles tal como se suben (por defecto).
+                RETAIN_COMPRESSED,                  ///< Conserva los niveles comprimidos con LZ4.
+                RETAIN_MAPPED_ASSET,                ///< Conserva el asset proyectado en memoria.
+                RETAIN_ASSET_PATH,                  ///< Solo conserva la ruta y vuelve a leer el asset.
+            };
+
             struct Options
             {
-                unsigned width;
-                unsigned height;
+                unsigned     width;
+                unsigned     height;
+                Pixel_Format pixel_format;          ///< Con PIXEL_FORMAT_AUTOMATIC (el valor por defecto) se analiza la imagen.
+                bool         dither;                ///< Tramado ordenado al reducir la precisión.
+                bool         mipmaps;               ///< Genera la cadena de mipmaps al cargar la imagen.
+                bool         trilinear;             ///< Con mipmaps, interpola también entre niveles.
+                bool         straight_alpha;        ///< Si es false (por defecto) el color se premultiplica por el alfa al cargar.
+                bool         trim;                  ///< Descarta los bordes transparentes (no apto para atlas).
+                Retention    retention;
+            };
+
+            /**
+             * Rectángulo de la imagen original (en texels y con el origen arriba a la izquierda)
+             * que se conserva cuando se recortan los bordes transparentes. Sin recorte abarca
+             * toda la imagen. get_width() y get_height() siempre dan el tamaño original.
+             */
+            struct Trim
+            {
+                float left;
+                float top;
+                float width;
+                float height;
             };
 
         public:
 
             typedef std::shared_ptr< Texture_2D > (* Factory) (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options);
 
+            /**
+             * Crea una textura a partir de bloques ETC. El puntero compressed_alpha es nulo salvo
+             * cuando el alfa se guarda aparte como una segunda imagen ETC1 en escala de grises.
+             */
+            typedef std::shared_ptr< Texture_2D > (* Compressed_Factory)
+            (
+                Id                  id,
+                Compressed_Buffer & compressed_buffer,
+                Compressed_Buffer * compressed_alpha,
+                const Options     & options
+            );
+
         private:
 
-            static Id      texture_2d_specialization_ids      [10];
-            static Factory texture_2d_specialization_factories[10];
-            static size_t  texture_2d_specialization_count;
+            static Id                 texture_2d_specialization_ids                 [10];
+            static Factory            texture_2d_specialization_factories           [10];
+            static size_t             texture_2d_specialization_count;
+
+            static Id                 texture_2d_compressed_specialization_ids      [10];
+            static Compressed_Factory texture_2d_compressed_specialization_factories[10];
+            static size_t             texture_2d_compressed_specialization_count;
 
         public:
 
@@ -52,25 +104,62 @@
                 texture_2d_specialization_count++;
             }
 
+            static void register_compressed_factory (Id id, Compressed_Factory factory)
+            {
+                texture_2d_compressed_specialization_ids      [texture_2d_compressed_specialization_count] = id;
+                texture_2d_compressed_specialization_factories[texture_2d_compressed_specialization_count] = factory;
+                texture_2d_compressed_specialization_count++;
+            }
+
         public:
 
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+            static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Compressed_Buffer & compressed_buffer, Compressed_Buffer * compressed_alpha = nullptr, const Options & options = {});
+
+            /**
+             * Carga una textura desde un asset PNG o PKM (ETC1/ETC2). Si la ruta de un PKM es
+             * "foo.pkm" y existe "foo.alpha.pkm", este último se usa como canal alfa.
+             */
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options = {});
 
         protected:
 
-            float width;
-            float height;
+            /**
+             * Asset del que procede la imagen. Los assets solo se conservan con
+             * RETAIN_MAPPED_ASSET.
+             */
+            struct Source
+            {
+                std::string              asset_path;
+                std::shared_ptr< Asset > asset;
+                std::shared_ptr< Asset > alpha_asset;
+            };
+
+        protected:
+
+            float     width;
+            float     height;
+            Trim      trim;
+            Retention retention;
+            Source    source;
 
         protected:
 
             Texture_2D(unsigned width, unsigned height)
             :
-                width (float(width )),
-                height(float(height))
+                width    (float(width )),
+                height   (float(height)),
+                trim     { 0.f, 0.f, float(width), float(height) },
+                retention(RETAIN_PIXELS)
             {
             }
 
+            /**
+             * Vuelve a decodificar la imagen original desde source. Las imágenes PNG se entregan
+             * en color_buffer sin ningún procesamiento y las PKM en los buffers comprimidos.
+             */
+            bool reload (Color_Buffer< Rgba8888 > & color_buffer, Compressed_Buffer & compressed_buffer, Compressed_Buffer & compressed_alpha) const;
+
         public:
 
             virtual ~Texture_2D() = default;
@@ -87,6 +176,31 @@
                 return height;
             }
 
+            const Trim & get_trim () const
+            {
+                return trim;
+            }
+
+            bool is_trimmed () const
+            {
+                return trim.width != width || trim.height != height;
+            }
+
+            Retention get_retention () const
+            {
+                return retention;
+            }
+
+            /**
+             * Bytes de los assets proyectados en memoria que se conservan con
+             * RETAIN_MAPPED_ASSET. Si proceden de archivos sin comprimir, el sistema puede
+             * descartar esas páginas cuando necesita memoria.
+             */
+            size_t get_mapped_asset_size () const
+            {
+                return (source.asset ? source.asset->size () : 0) + (source.alpha_asset ? source.alpha_asset->size () : 0);
+            }
+
         };
 
     }
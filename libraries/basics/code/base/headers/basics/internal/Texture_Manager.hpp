@@ -0,0 +1,147 @@
+/*
+ * TEXTURE MANAGER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181820
+ */
+
+#ifndef BASICS_TEXTURE_MANAGER_HEADER
+#define BASICS_TEXTURE_MANAGER_HEADER
+
+    #include <map>
+    #include <memory>
+    #include <string>
+    #include <cstdint>
+    #include <basics/Graphics_Context>
+    #include <basics/Graphics_Resource_Cache>
+    #include <basics/Non_Copyable>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Comparte entre escenas las texturas que se cargan desde assets. Cada textura se
+         * identifica por la ruta del asset y las opciones con las que se carga, de modo que pedir
+         * otra vez la misma no la vuelve a decodificar ni a subir a la GPU.
+         * El gestor conserva una referencia a cada textura. Las que nadie más usa se quedan
+         * cargadas mientras la memoria que ocupan (GPU y CPU) no supere el presupuesto y, al
+         * superarlo, trim() elimina primero las que hace más tiempo que no se piden.
+         */
+        class Texture_Manager : Non_Copyable
+        {
+        public:
+
+            typedef std::shared_ptr< Texture_2D > Texture_Handle;
+
+            struct Metrics
+            {
+                size_t hits;                        ///< Peticiones atendidas con una textura ya cargada.
+                size_t misses;                      ///< Peticiones que han cargado la textura.
+                size_t evictions;                   ///< Texturas eliminadas para respetar el presupuesto.
+                size_t textures;                    ///< Texturas que conserva el gestor.
+                size_t unused_textures;             ///< De ellas, las que nadie más usa.
+                size_t unused_bytes;                ///< Memoria que ocupan las que nadie más usa.
+            };
+
+        private:
+
+            struct Entry
+            {
+                Texture_Handle                  texture;
+                Graphics_Resource_Cache::Handle cache_handle;
+                uint64_t                        last_use;
+            };
+
+            typedef std::map< std::string, Entry > Entry_Map;
+
+        private:
+
+            Entry_Map                 entries;
+            size_t                    budget;
+            uint64_t                  clock;
+            Metrics                   metrics;
+            Graphics_Resource_Cache * cache;
+
+        public:
+
+            Texture_Manager(size_t budget = 16 * 1024 * 1024)
+            :
+                budget (budget ),
+                clock  (0      ),
+                metrics(      ),
+                cache  (nullptr)
+            {
+            }
+
+        public:
+
+            /**
+             * Retorna la textura del asset cargándola si no la tiene ya. Las texturas nuevas se
+             * suben en segundo plano (ver Graphics_Context::add_in_background()), por lo que hasta
+             * que no hay subidas pendientes puede que aún no sean usables.
+             * @return La textura o nullptr si no se ha podido cargar.
+             */
+            Texture_Handle acquire
+            (
+                Id id,
+                Graphics_Context::Accessor & context,
+                const std::string & asset_path,
+                const Texture_2D::Options & options = {}
+            );
+
+            bool contains (const std::string & asset_path, const Texture_2D::Options & options = {}) const
+            {
+                return entries.count (make_key (asset_path, options)) > 0;
+            }
+
+            /**
+             * Elimina las texturas que nadie usa, empezando por las que hace más tiempo que no se
+             * piden, hasta que las restantes caben en el presupuesto. Se debe llamar en el hilo en
+             * el que el contexto está activo (el Director lo hace al cambiar de escena).
+             */
+            void trim ()
+            {
+                trim (budget);
+            }
+
+            /**
+             * Elimina todas las texturas que nadie usa.
+             */
+            void clear ()
+            {
+                trim (0);
+            }
+
+        public:
+
+            void set_budget (size_t new_budget)
+            {
+                budget = new_budget;
+            }
+
+            size_t get_budget () const
+            {
+                return budget;
+            }
+
+            const Metrics & get_metrics ();
+
+        private:
+
+            void trim (size_t byte_limit);
+
+            static std::string make_key  (const std::string & asset_path, const Texture_2D::Options & options);
+            static size_t      get_size  (const Texture_2D & texture);
+            static bool        is_unused (const Entry & entry);
+
+        };
+
+    }
+
+#endif
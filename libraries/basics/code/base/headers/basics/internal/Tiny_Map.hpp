@@ -13,58 +13,174 @@
 #ifndef BASICS_TINY_MAP_HEADER
 #define BASICS_TINY_MAP_HEADER
 
+    #include <new>
+    #include <memory>
+    #include <utility>
+    #include <cstdint>
+    #include <type_traits>
     #include <basics/types>
     #include <basics/assert>
+    #include <basics/macros>
+
+    #if   defined(BASICS_NEON_SUPPORTED)
+        #include <arm_neon.h>
+    #elif defined(BASICS_SSE2_SUPPORTED)
+        #include <emmintrin.h>
+    #endif
 
     namespace basics
     {
 
-        template< typename KEY, typename VALUE, size_t CAPACITY >
+        /**
+         * Mapa para pocos elementos que los guarda dentro del propio objeto, sin reservar memoria.
+         * Las claves se guardan en un array aparte de los valores y se buscan recorriéndolas
+         * linealmente, lo que con pocas claves es más rápido que recorrer un árbol o calcular un
+         * hash. Con claves de 32 bits (como Id) se comparan 4 a la vez con NEON o SSE2.
+         * Si se supera CAPACITY, con SPILL los elementos pasan a memoria dinámica y en otro caso
+         * es un error. Al eliminar un elemento su lugar lo ocupa el último, por lo que el orden
+         * del recorrido no se conserva.
+         */
+        template< typename KEY, typename VALUE, size_t CAPACITY, bool SPILL = true >
         class Tiny_Map
         {
+            static_assert (CAPACITY > 0, "Tiny_Map needs some inline capacity");
+
+        public:
+
             typedef KEY   Key;
             typedef VALUE Value;
 
-            static constexpr size_t capacity = CAPACITY;
+        private:
+
+            // Con claves de 32 bits el espacio de las claves se redondea a múltiplos de 4 para que
+            // la búsqueda vectorial pueda leer grupos completos:
 
-            struct Item
-            {
-                Key   key;
-                Value value,
-            };
+            static constexpr bool   simd_keys       = std::is_integral< Key >::value && sizeof(Key) == 4;
+            static constexpr size_t inline_capacity = (CAPACITY + 3) & ~size_t(3);
 
-            template< class ITEM >
+            typedef typename std::aligned_storage< sizeof(Value), alignof(Value) >::type Value_Storage;
+
+            template< class MAP, class VALUE_TYPE >
             class Iterator_Template
             {
 
-                ITEM * item;
+                friend class Tiny_Map;
+
+                MAP  * map;
+                size_t index;
 
             public:
 
-                Iterator()            : item(nullptr) { }
-                Iterator(Item * item) : item(item   ) { }
+                Iterator_Template() : map(nullptr), index(0)
+                {
+                }
+
+                Iterator_Template(MAP * map, size_t index) : map(map), index(index)
+                {
+                }
 
-                      Value & operator  * ()       { return  item->value; }
-                const Value & operator  * () const { return  item->value; }
+                const Key & key () const
+                {
+                    return map->keys[index];
+                }
+
+                VALUE_TYPE & value () const
+                {
+                    return map->values[index];
+                }
 
-                      Value * operator -> ()       { return &item->value; }
-                const Value * operator -> () const { return &item->value; }
+                VALUE_TYPE & operator  * () const { return  map->values[index]; }
+                VALUE_TYPE * operator -> () const { return &map->values[index]; }
 
-                operator bool () const
+                Iterator_Template & operator ++ ()
                 {
-                    return item != nullptr;
+                    ++index;
+                    return *this;
                 }
+
+                bool operator == (const Iterator_Template & other) const
+                {
+                    return map == other.map && index == other.index;
+                }
+
+                bool operator != (const Iterator_Template & other) const
+                {
+                    return !(*this == other);
+                }
+
             };
 
         public:
 
-            typedef Iterator_Template<       Item >       Iterator;
-            typedef Iterator_Template< const Item > Const_Iterator;
+            typedef Iterator_Template<       Tiny_Map,       Value >       Iterator;
+            typedef Iterator_Template< const Tiny_Map, const Value > Const_Iterator;
 
         private:
 
-            Item   items[capacity];
-            size_t count;
+            Key    * keys;
+            Value  * values;
+            size_t   count;
+            size_t   allocated;                     ///< Capacidad de los arrays en uso.
+
+            Key           inline_keys  [inline_capacity];
+            Value_Storage inline_values[CAPACITY];
+
+        public:
+
+            Tiny_Map()
+            :
+                keys     (inline_keys),
+                values   (reinterpret_cast< Value * >(inline_values)),
+                count    (0),
+                allocated(CAPACITY),
+                inline_keys()
+            {
+            }
+
+            Tiny_Map(const Tiny_Map & other) : Tiny_Map()
+            {
+                reserve (other.count);
+
+                for (size_t index = 0; index < other.count; ++index)
+                {
+                    append (other.keys[index], other.values[index]);
+                }
+            }
+
+            Tiny_Map(Tiny_Map && other) : Tiny_Map()
+            {
+                take (other);
+            }
+
+           ~Tiny_Map()
+            {
+                clear ();
+                release_heap ();
+            }
+
+            Tiny_Map & operator = (const Tiny_Map & other)
+            {
+                if (this != &other)
+                {
+                    Tiny_Map copy(other);
+
+                    clear ();
+                    take  (copy);
+                }
+
+                return *this;
+            }
+
+            Tiny_Map & operator = (Tiny_Map && other)
+            {
+                if (this != &other)
+                {
+                    clear ();
+                    take  (other);
+                }
+
+                return *this;
+            }
 
         public:
 
@@ -73,55 +189,289 @@
                 return count;
             }
 
+            bool empty () const
+            {
+                return count == 0;
+            }
+
+            /**
+             * Cantidad de elementos que caben sin reservar más memoria.
+             */
             size_t capacity () const
             {
-                return capacity;
+                return allocated;
+            }
+
+            bool is_inline () const
+            {
+                return keys == inline_keys;
             }
 
         public:
 
-            Iterator begin ()
+            Iterator       begin ()       { return       Iterator(this, 0    ); }
+            Iterator       end   ()       { return       Iterator(this, count); }
+            Const_Iterator begin () const { return Const_Iterator(this, 0    ); }
+            Const_Iterator end   () const { return Const_Iterator(this, count); }
+
+        public:
+
+            Iterator find (const Key & key)
             {
-                return Iterator(items[0]);
+                return Iterator(this, find_index (key));
             }
 
-            Const_Iterator cbegin () const
+            Const_Iterator find (const Key & key) const
             {
-                return Const_Iterator(items[0]);
+                return Const_Iterator(this, find_index (key));
             }
 
-            Iterator end ()
+            bool contains (const Key & key) const
             {
-                return Iterator(items[count]);
+                return find_index (key) < count;
             }
 
-            Const_Iterator cend () const
+            /**
+             * @return Puntero al valor o nullptr si la clave no está.
+             */
+            Value * get (const Key & key)
             {
-                return Const_Iterator(items[count]);
+                size_t index = find_index (key);
+                return index < count ? &values[index] : nullptr;
             }
 
-        public:
+            const Value * get (const Key & key) const
+            {
+                size_t index = find_index (key);
+                return index < count ? &values[index] : nullptr;
+            }
 
+            /**
+             * Si la clave no está se añade con un valor construido por defecto.
+             */
             Value & operator [] (const Key & key)
             {
-                for (size_t  index = 0; index < count; ++index)
+                size_t index = find_index (key);
+
+                return index < count ? values[index] : append (key, Value());
+            }
+
+            /**
+             * Añade el par si la clave no estaba. El booleano indica si se ha añadido.
+             */
+            template< typename ARGUMENT >
+            std::pair< Iterator, bool > insert (const Key & key, ARGUMENT && value)
+            {
+                size_t index = find_index (key);
+
+                if (index < count) return { Iterator(this, index), false };
+
+                append (key, std::forward< ARGUMENT > (value));
+
+                return { Iterator(this, count - 1), true };
+            }
+
+            bool erase (const Key & key)
+            {
+                size_t index = find_index (key);
+
+                if (index < count)
+                {
+                    erase (Iterator(this, index));
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * El último elemento pasa a ocupar la posición del eliminado, por lo que el iterador
+             * sigue siendo válido y apunta al siguiente elemento por recorrer.
+             */
+            Iterator erase (Iterator position)
+            {
+                size_t index = position.index;
+                size_t last  = count - 1;
+
+                assert(index < count);
+
+                if (index != last)
                 {
-                    if (item[index].key == key) return item[index].value;
+                    keys  [index] = keys[last];
+                    values[index] = std::move (values[last]);
                 }
 
-                assert(count < capacity);
+                values[last].~Value ();
+                count--;
+
+                return Iterator(this, index);
+            }
+
+            void clear ()
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    values[index].~Value ();
+                }
 
-                return item[count].key = key, item[count++];
+                count = 0;
             }
 
-            const Value & operator [] (const Key & key) const
+            void reserve (size_t new_capacity)
             {
-                for (auto & item : items)
+                if (new_capacity > allocated)
                 {
-                    if (item.key == key) return item.value;
+                    assert(SPILL);
+
+                    grow (new_capacity);
                 }
+            }
+
+        private:
+
+            size_t find_index (const Key & key) const
+            {
+                return find_index (key, std::integral_constant< bool, simd_keys >());
+            }
+
+            size_t find_index (const Key & key, std::false_type) const
+            {
+                size_t index = 0;
+
+                while (index < count && !(keys[index] == key)) ++index;
+
+                return index;
+            }
+
+            size_t find_index (const Key & key, std::true_type) const
+            {
+                size_t index = 0;
+
+                // Se leen grupos de 4 claves. Las posiciones a partir de count pueden tener
+                // claves antiguas, así que el resultado se descarta si cae fuera:
+
+                #if defined(BASICS_NEON_SUPPORTED)
+
+                    const uint32x4_t target = vdupq_n_u32 (uint32_t(key));
+
+                    for ( ; index < count; index += 4)
+                    {
+                        uint32x4_t equal = vceqq_u32 (vld1q_u32 (reinterpret_cast< const uint32_t * >(keys + index)), target);
+                        uint64_t   mask  = vget_lane_u64 (vreinterpret_u64_u16 (vmovn_u32 (equal)), 0);
+
+                        if (mask != 0)
+                        {
+                            index += size_t(__builtin_ctzll (mask)) >> 4;
+                            return index < count ? index : count;
+                        }
+                    }
+
+                    return count;
+
+                #elif defined(BASICS_SSE2_SUPPORTED)
+
+                    const __m128i target = _mm_set1_epi32 (int(key));
 
-                return *reinterpret_cast< Value * >(nullptr);
+                    for ( ; index < count; index += 4)
+                    {
+                        __m128i equal = _mm_cmpeq_epi32 (_mm_loadu_si128 (reinterpret_cast< const __m128i * >(keys + index)), target);
+                        int     mask  = _mm_movemask_ps (_mm_castsi128_ps (equal));
+
+                        if (mask != 0)
+                        {
+                            index += size_t(__builtin_ctz (unsigned(mask)));
+                            return index < count ? index : count;
+                        }
+                    }
+
+                    return count;
+
+                #else
+
+                    return find_index (key, std::false_type());
+
+                #endif
+            }
+
+            template< typename ARGUMENT >
+            Value & append (const Key & key, ARGUMENT && value)
+            {
+                if (count == allocated)
+                {
+                    assert(SPILL);
+
+                    grow (allocated * 2);
+                }
+
+                Value * slot = new (values + count) Value(std::forward< ARGUMENT > (value));
+
+                keys[count++] = key;
+
+                return *slot;
+            }
+
+            void grow (size_t new_capacity)
+            {
+                new_capacity = (new_capacity + 3) & ~size_t(3);
+
+                std::unique_ptr< Key[] > new_keys  (new Key[new_capacity]());
+                Value_Storage          * new_values = new Value_Storage[new_capacity];
+
+                for (size_t index = 0; index < count; ++index)
+                {
+                    new_keys[index] = keys[index];
+                    new (reinterpret_cast< Value * >(new_values) + index) Value(std::move (values[index]));
+                    values[index].~Value ();
+                }
+
+                release_heap ();
+
+                keys      = new_keys.release ();
+                values    = reinterpret_cast< Value * >(new_values);
+                allocated = new_capacity;
+            }
+
+            void release_heap ()
+            {
+                if (!is_inline ())
+                {
+                    delete [] keys;
+                    delete [] reinterpret_cast< Value_Storage * >(values);
+
+                    keys      = inline_keys;
+                    values    = reinterpret_cast< Value * >(inline_values);
+                    allocated = CAPACITY;
+                }
+            }
+
+            /**
+             * Toma los elementos de other (que queda vacío). El mapa debe estar vacío.
+             */
+            void take (Tiny_Map & other)
+            {
+                release_heap ();
+
+                if (other.is_inline ())
+                {
+                    for (size_t index = 0; index < other.count; ++index)
+                    {
+                        append (other.keys[index], std::move (other.values[index]));
+                    }
+
+                    other.clear ();
+                }
+                else
+                {
+                    keys      = other.keys;
+                    values    = other.values;
+                    count     = other.count;
+                    allocated = other.allocated;
+
+                    other.keys      = other.inline_keys;
+                    other.values    = reinterpret_cast< Value * >(other.inline_values);
+                    other.count     = 0;
+                    other.allocated = CAPACITY;
+                }
             }
 
         };
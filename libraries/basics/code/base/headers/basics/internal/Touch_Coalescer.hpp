@@ -0,0 +1,154 @@
+/*
+ * TOUCH COALESCER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181850
+ */
+
+#ifndef BASICS_TOUCH_COALESCER_HEADER
+#define BASICS_TOUCH_COALESCER_HEADER
+
+    #include <vector>
+    #include <cstdint>
+    #include <algorithm>
+    #include <basics/Event>
+    #include <basics/Tiny_Map>
+
+    namespace basics
+    {
+
+        /**
+         * Agrupa los eventos que llegan entre dos fotogramas sin alterar su orden. Los touch-moved
+         * de un mismo puntero se funden en uno solo con la última posición y las anteriores se
+         * guardan en su historial (hasta history_capacity, descartando las más antiguas). Solo se
+         * funden movimientos entre los que no ha llegado nada más que movimientos de otros
+         * punteros, de modo que ningún evento se entrega antes que otro que llegó antes que él.
+         * Los demás eventos (touch-started, touch-ended, teclas...) nunca se descartan ni se
+         * agrupan.
+         *
+         * Así la cantidad de eventos que se atienden por fotograma depende del número de dedos y
+         * no de la frecuencia con la que muestrea la pantalla.
+         *
+         * No se bloquea en ningún momento porque solo lo usa el hilo que consume los eventos: los
+         * productores escriben en una Event_Queue y el consumidor los pasa aquí mientras la vacía.
+         */
+        class Touch_Coalescer
+        {
+        public:
+
+            static constexpr unsigned history_capacity = 16;
+
+            typedef Event::Touch_Sample Sample;
+
+        private:
+
+            struct Record
+            {
+                Event  event;
+                Sample history[history_capacity];
+            };
+
+            typedef std::vector< Record >             Record_List;
+            typedef Tiny_Map< int32_t, size_t, 10 >   Open_Move_Map;       ///< Puntero -> touch-moved que aún admite muestras.
+
+        private:
+
+            Record_List   pending;
+            Record_List   ready;
+            Open_Move_Map open_moves;
+            Sample        latched_history[history_capacity];
+            uint64_t      received_count;
+            uint64_t      dispatched_count;
+
+        public:
+
+            Touch_Coalescer() : received_count(0), dispatched_count(0)
+            {
+            }
+
+            /**
+             * Añade un evento de cualquier tipo detrás de los anteriores.
+             */
+            void push (Event && event);
+
+            void push (const Event & event)
+            {
+                push (Event(event));
+            }
+
+            /**
+             * Entrega en orden los eventos agrupados desde la llamada anterior. handler recibe un
+             * Event & y puede modificarlo (incluido el historial de los toques) antes de usarlo.
+             */
+            template< class HANDLER >
+            void dispatch (HANDLER && handler)
+            {
+                // Los vectores se intercambian para no reservar memoria en cada fotograma:
+
+                ready.swap (pending);
+                open_moves.clear ();
+
+                for (Record & record : ready)
+                {
+                    Event & event = record.event;
+
+                    if (event.kind == Event::TOUCH)
+                    {
+                        event.touch.history = event.touch.history_size > 0 ? record.history : nullptr;
+
+                        dispatched_count++;
+                    }
+
+                    handler (event);
+                }
+
+                ready.clear ();
+            }
+
+            /**
+             * Entrega una copia de los eventos de toque pendientes sin retirarlos, de modo que
+             * dispatch() los volverá a entregar. Sirve para echar un vistazo a la entrada más
+             * reciente justo antes de dibujar.
+             */
+            template< class HANDLER >
+            void peek (HANDLER && handler)
+            {
+                for (const Record & record : pending)
+                {
+                    if (record.event.kind != Event::TOUCH) continue;
+
+                    Event event(record.event.id);
+
+                    event.kind          = Event::TOUCH;
+                    event.touch         = record.event.touch;
+                    event.touch.history = event.touch.history_size > 0 ? latched_history : nullptr;
+
+                    std::copy (record.history, record.history + event.touch.history_size, latched_history);
+
+                    handler (event);
+                }
+            }
+
+            /**
+             * Cantidad de eventos de toque recibidos y entregados hasta el momento.
+             */
+            uint64_t get_received_count () const
+            {
+                return received_count;
+            }
+
+            uint64_t get_dispatched_count () const
+            {
+                return dispatched_count;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * TOUCH PREDICTOR
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181860
+ */
+
+#ifndef BASICS_TOUCH_PREDICTOR_HEADER
+#define BASICS_TOUCH_PREDICTOR_HEADER
+
+    #include <cstdint>
+    #include <basics/Event>
+    #include <basics/Tiny_Map>
+
+    namespace basics
+    {
+
+        /**
+         * Estima dónde estará cada puntero dentro de poco (normalmente cuando se muestre el
+         * fotograma que se está preparando) ajustando por mínimos cuadrados una recta a sus últimas
+         * muestras (posición en función del tiempo) y extrapolándola.
+         *
+         * Se le pasan los eventos de toque que recibe la escena (con su historial) y se le pregunta
+         * por la posición prevista. Los tiempos están en nanosegundos en el reloj de los eventos,
+         * que en Android coincide con el de get_time().
+         */
+        class Touch_Predictor
+        {
+        public:
+
+            typedef Event::Touch_Sample Sample;
+
+            static constexpr unsigned max_samples = 8;
+
+        private:
+
+            struct Track
+            {
+                Sample   samples[max_samples];               ///< Búfer circular.
+                unsigned first;
+                unsigned count;
+            };
+
+            typedef Tiny_Map< int32_t, Track, 4 > Track_Map;
+
+        private:
+
+            Track_Map tracks;
+            float     horizon;                              ///< Segundos que se adelanta predict() por defecto.
+            float     window;                               ///< Antigüedad máxima de las muestras que se ajustan.
+            float     max_sample_age;                       ///< Si la última muestra es más vieja, el puntero se da por parado.
+
+        public:
+
+            Touch_Predictor(float horizon = 1.f / 60.f) : horizon(horizon), window(.03f), max_sample_age(.05f)
+            {
+            }
+
+            /**
+             * Tiempo actual en el reloj de los eventos (nanosegundos).
+             */
+            static int64_t get_time ();
+
+        public:
+
+            void  set_horizon (float seconds) { horizon = seconds; }
+            float get_horizon () const        { return horizon;    }
+
+            /**
+             * Cuántos segundos hacia atrás se tienen en cuenta para estimar la velocidad. Con más
+             * muestras hay menos ruido pero reacciona más tarde a los cambios de dirección.
+             */
+            void  set_window (float seconds) { window = seconds; }
+            float get_window () const        { return window;    }
+
+            void  set_max_sample_age (float seconds) { max_sample_age = seconds; }
+
+        public:
+
+            /**
+             * Registra un evento de toque (touch-started, touch-moved o touch-ended). Los demás
+             * eventos se ignoran.
+             */
+            void handle (const Event & event);
+
+            void add_sample (int32_t pointer_id, const Sample & sample);
+
+            void remove (int32_t pointer_id)
+            {
+                tracks.erase (pointer_id);
+            }
+
+            void clear ()
+            {
+                tracks.clear ();
+            }
+
+            bool is_tracking (int32_t pointer_id) const
+            {
+                return tracks.contains (pointer_id);
+            }
+
+            /**
+             * Posición prevista del puntero en el instante indicado. Retorna false si el puntero no
+             * se está siguiendo. Nunca se extrapola más allá de horizon desde la última muestra.
+             */
+            bool predict (int32_t pointer_id, int64_t time, Sample & prediction) const;
+
+            /**
+             * Posición prevista dentro de horizon segundos.
+             */
+            bool predict (int32_t pointer_id, Sample & prediction) const
+            {
+                return predict (pointer_id, get_time () + int64_t(horizon * 1e9f), prediction);
+            }
+
+        };
+
+    }
+
+#endif
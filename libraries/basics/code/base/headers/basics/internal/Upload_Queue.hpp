@@ -0,0 +1,148 @@
+/*
+ * UPLOAD QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181720
+ */
+
+#ifndef BASICS_UPLOAD_QUEUE_HEADER
+#define BASICS_UPLOAD_QUEUE_HEADER
+
+    #include <map>
+    #include <deque>
+    #include <memory>
+    #include <basics/Graphics_Resource>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Reparte entre varios fotogramas la transferencia a la GPU de los recursos gráficos para
+         * que subir muchas texturas de golpe (al cargar una escena o al recuperar el contexto) no
+         * congele la imagen. En cada fotograma process() inicializa recursos por orden de
+         * prioridad hasta agotar el presupuesto de tiempo o de bytes. Las texturas grandes se
+         * suben por franjas de filas, por lo que una sola puede ocupar varios fotogramas.
+         * Solo se debe usar con el contexto gráfico bloqueado y activo.
+         */
+        class Upload_Queue : Non_Copyable
+        {
+        public:
+
+            enum Priority
+            {
+                PRIORITY_VISIBLE,                   ///< Recursos que se van a dibujar ya.
+                PRIORITY_NORMAL,
+                PRIORITY_BACKGROUND,                ///< Recursos que se usarán más adelante.
+                PRIORITY_COUNT
+            };
+
+            /**
+             * Límites por fotograma. Se respeta el primero que se alcance, pero al menos se
+             * avanza un paso en cada llamada a process() para que la cola no se estanque.
+             */
+            struct Budget
+            {
+                float  milliseconds;
+                size_t bytes;
+            };
+
+            struct Metrics
+            {
+                size_t pending_resources;           ///< Recursos que siguen en la cola.
+                size_t pending_bytes;               ///< Estimación de lo que les falta por subir.
+                size_t peak_pending_resources;      ///< Máximo de recursos encolados a la vez.
+                size_t uploaded_resources;          ///< Recursos completados en el último process().
+                size_t uploaded_bytes;              ///< Bytes subidos en el último process().
+                float  milliseconds;                ///< Tiempo empleado en el último process().
+            };
+
+        private:
+
+            typedef std::weak_ptr< Graphics_Resource > Resource_Reference;
+
+            /**
+             * Estado de cada recurso encolado. Si un recurso se adelanta a otra cola, su entrada
+             * en la anterior se queda donde estaba y se descarta al llegar su turno, de modo que
+             * push() no tiene que recorrer las colas.
+             */
+            struct Queued
+            {
+                Priority priority;                  ///< Cola en la que está su entrada válida.
+                size_t   pending_bytes;             ///< Lo que aporta a metrics.pending_bytes.
+            };
+
+            typedef std::deque< Resource_Reference > Queue;
+            typedef std::map< Resource_Reference, Queued, std::owner_less< Resource_Reference > > Queued_Map;
+
+            Queue      queues[PRIORITY_COUNT];
+            Queued_Map queued;
+            Budget     budget;
+            Metrics    metrics;
+
+        public:
+
+            Upload_Queue()
+            :
+                budget { 2.f, 1024 * 1024 },
+                metrics{ }
+            {
+            }
+
+        public:
+
+            void set_budget (const Budget & new_budget)
+            {
+                budget = new_budget;
+            }
+
+            const Budget & get_budget () const
+            {
+                return budget;
+            }
+
+            const Metrics & get_metrics () const
+            {
+                return metrics;
+            }
+
+            bool empty () const
+            {
+                return metrics.pending_resources == 0;
+            }
+
+        public:
+
+            /**
+             * Encola un recurso. Si ya estaba encolado con menos prioridad se adelanta.
+             */
+            void push (const std::shared_ptr< Graphics_Resource > & resource, Priority priority = PRIORITY_NORMAL);
+
+            /**
+             * Sube lo que permita el presupuesto. Se debe llamar una vez por fotograma antes de
+             * dibujar.
+             */
+            void process ();
+
+            /**
+             * Sube todo lo pendiente sin tener en cuenta el presupuesto.
+             */
+            void flush ();
+
+            void clear ();
+
+        private:
+
+            void upload  (const Budget & budget);
+            void dequeue (Queue & queue, Queued_Map::iterator entry);
+
+        };
+
+    }
+
+#endif
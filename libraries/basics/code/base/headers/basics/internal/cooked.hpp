@@ -0,0 +1,84 @@
+/*
+ * COOKED
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181700
+ */
+
+#ifndef BASICS_COOKED_HEADER
+#define BASICS_COOKED_HEADER
+
+    #include <string>
+    #include <vector>
+    #include <basics/types>
+
+    namespace basics { namespace cooked
+    {
+
+        /**
+         * Los datos de los atlas (.sprites de darkFunction Editor) y de las fuentes (.fnt XML de
+         * BMFont) se pueden convertir previamente a un formato binario que se carga sin parsear.
+         * Atlas y Raster_Font usan "foo.sprites.bin" o "foo.fnt.bin" si existen junto al XML.
+         * Los valores se guardan en el orden de bytes de la máquina que cocina los datos (para que
+         * se puedan cargar copiándolos sin convertir) y la cabecera lo indica. Si no coincide con
+         * el de la máquina que los carga, el archivo se rechaza y se usa el XML.
+         */
+        extern const char * const suffix;
+
+        struct Slice
+        {
+            uint32_t id;                                        ///< FNV-1a de la ruta del slice (p.e. "dir.name").
+            float    x;
+            float    y;
+            float    width;
+            float    height;
+        };
+
+        struct Atlas_Data
+        {
+            std::string          texture_name;                  ///< Relativo a la carpeta del atlas.
+            std::vector< Slice > slices;                        ///< Ordenados por id.
+        };
+
+        struct Glyph
+        {
+            float x;
+            float y;
+            float width;                                        ///< 0 si el código no tiene glifo.
+            float height;
+            float x_offset;
+            float y_offset;
+            float advance;
+        };
+
+        struct Font_Data
+        {
+            std::string          name;
+            std::string          texture_name;                  ///< Relativo a la carpeta de la fuente.
+            float                line_height;
+            float                base_height;
+            uint32_t             first_code;
+            std::vector< Glyph > glyphs;                        ///< El glifo de un código está en glyphs[code - first_code].
+        };
+
+        /**
+         * Interpretan el XML original. El buffer se modifica (se le añade un caracter nulo y el
+         * parseador escribe sobre él).
+         */
+        bool parse_atlas_xml (std::vector< byte > & xml, Atlas_Data & atlas_data);
+        bool parse_font_xml  (std::vector< byte > & xml, Font_Data  & font_data );
+
+        bool read_atlas (const byte * data, size_t size, Atlas_Data & atlas_data);
+        bool read_font  (const byte * data, size_t size, Font_Data  & font_data );
+
+        void write_atlas (const Atlas_Data & atlas_data, std::vector< byte > & data);
+        void write_font  (const Font_Data  & font_data,  std::vector< byte > & data);
+
+    }}
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * LZ4
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181600
+ */
+
+#ifndef BASICS_LZ4_HEADER
+#define BASICS_LZ4_HEADER
+
+    #include <vector>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Comprime con el formato de bloque de LZ4 (sin la cabecera del formato de frame), que
+         * cualquier implementación de LZ4 puede descomprimir. Prima la velocidad sobre el ratio.
+         */
+        void lz4_compress (const byte * data, size_t size, std::vector< byte > & compressed_data);
+
+        /**
+         * Descomprime un bloque LZ4 cuyo tamaño original debe conocerse de antemano.
+         * @return false si los datos están corruptos o no ocupan exactamente size bytes.
+         */
+        bool lz4_decompress (const byte * compressed_data, size_t compressed_size, byte * data, size_t size);
+
+    }
+
+#endif
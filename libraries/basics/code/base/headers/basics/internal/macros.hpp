@@ -260,4 +260,18 @@
 
     #endif
 
+   /* --------------------------------------------------------------------------------------------- +
+                          Detect the SIMD instruction sets enabled for the target
+    + --------------------------------------------------------------------------------------------- */
+
+    #if defined(BASICS_ARM_ARCHITECTURE) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+
+        #define BASICS_NEON_SUPPORTED
+
+    #elif defined(BASICS_AMD64_ARCHITECTURE) || (defined(BASICS_IA32_ARCHITECTURE) && defined(__SSE2__))
+
+        #define BASICS_SSE2_SUPPORTED
+
+    #endif
+
 #endif
@@ -13,6 +13,8 @@
 namespace basics
 {
 
+    constexpr size_t Accelerometer::history_capacity;
+
     //Accelerometer * const accelerometer = Accelerometer::get_instance ();
 
 }
@@ -0,0 +1,65 @@
+/*
+ * ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181620
+ */
+
+#include <basics/Asset>
+#include <basics/Asset_Pack>
+
+namespace basics
+{
+
+    std::shared_ptr< Asset > Asset::open (const std::string & path)
+    {
+        const Asset_Pack * pack = Asset_Pack::get_default ();
+
+        if (pack)
+        {
+            const Asset_Pack::Entry * entry = pack->find (path);
+
+            if (entry) return pack->open (*entry);
+        }
+
+        return open_file (path);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset::exists (const std::string & path)
+    {
+        const Asset_Pack * pack = Asset_Pack::get_default ();
+
+        if (pack && pack->find (path))
+        {
+            return true;
+        }
+
+        return open_file (path) != nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t Asset::size (const std::string & path)
+    {
+        const Asset_Pack * pack = Asset_Pack::get_default ();
+
+        if (pack)
+        {
+            const Asset_Pack::Entry * entry = pack->find (path);
+
+            if (entry) return entry->size;
+        }
+
+        std::shared_ptr< Asset > file = open_file (path);
+
+        return file ? file->size () : 0;
+    }
+
+}
@@ -0,0 +1,247 @@
+/*
+ * ASSET PACK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181610
+ */
+
+#include <cstring>
+#include <basics/Asset_Pack>
+#include <basics/lz4>
+
+namespace basics
+{
+
+    const uint32_t Asset_Pack::magic;
+    const uint32_t Asset_Pack::version;
+    const uint32_t Asset_Pack::alignment;
+    const char   * Asset_Pack::default_path = "assets.pak";
+
+    namespace
+    {
+
+        /**
+         * Asset de solo lectura sobre un bloque de memoria. Mantiene abierto el archivo del que
+         * procede para que la memoria no deje de ser válida y, si el contenido estaba comprimido,
+         * guarda el resultado de descomprimirlo.
+         */
+        class Memory_Asset final : public Asset
+        {
+
+            std::shared_ptr< Asset > owner;
+            std::vector< byte >      buffer;
+            View                     view;
+            size_t                   cursor;
+            bool                     at_end;
+
+        public:
+
+            Memory_Asset(const std::shared_ptr< Asset > & owner, const View & view)
+            :
+                owner (owner),
+                view  (view ),
+                cursor(0    ),
+                at_end(false)
+            {
+            }
+
+            Memory_Asset(std::vector< byte > & decompressed_data)
+            :
+                cursor(0    ),
+                at_end(false)
+            {
+                buffer.swap (decompressed_data);
+
+                view = { buffer.data (), buffer.size () };
+            }
+
+        public:
+
+            bool   good () const override { return true;      }
+            bool   fail () const override { return false;     }
+            bool   eof  () const override { return at_end;    }
+            size_t size () const override { return view.size; }
+            size_t tell () const override { return cursor;    }
+
+            bool seek (ptrdiff_t offset, Anchor anchor) override
+            {
+                ptrdiff_t base     = anchor == BEGINNING ? 0 : anchor == END ? ptrdiff_t(view.size) : ptrdiff_t(cursor);
+                ptrdiff_t position = base + offset;
+
+                if (position < 0 || size_t(position) > view.size) return false;
+
+                cursor = size_t(position);
+                at_end = false;
+
+                return true;
+            }
+
+            byte read () override
+            {
+                if (cursor < view.size) return view.data[cursor++];
+
+                at_end = true;
+
+                return 0;
+            }
+
+            size_t read_some (byte * buffer, size_t size) override
+            {
+                size_t available = view.size - cursor;
+
+                if (size > available)
+                {
+                    size   = available;
+                    at_end = true;
+                }
+
+                if (size > 0) std::memcpy (buffer, view.data + cursor, size);
+
+                cursor += size;
+
+                return size;
+            }
+
+            bool read_all (std::vector< byte > & buffer) override
+            {
+                buffer.assign (view.begin (), view.end ());
+
+                return true;
+            }
+
+            bool read_all (std::string & buffer) override
+            {
+                buffer.assign (reinterpret_cast< const char * >(view.begin ()), view.size);
+
+                return true;
+            }
+
+            View map (Access ) override
+            {
+                return view;
+            }
+
+        };
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const Asset_Pack * Asset_Pack::get_default ()
+    {
+        // La inicialización de una variable estática local es segura entre hilos:
+
+        static const std::unique_ptr< Asset_Pack > default_pack = []
+        {
+            std::shared_ptr< Asset > file = Asset::open_file (default_path);
+
+            std::unique_ptr< Asset_Pack > pack(file ? new Asset_Pack(file) : nullptr);
+
+            if (pack && !pack->good ()) pack.reset ();
+
+            return pack;
+        }
+        ();
+
+        return default_pack.get ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Pack::Asset_Pack(const std::shared_ptr< Asset > & file)
+    :
+        file      (file   ),
+        data      (file->map (Asset::RANDOM)),
+        slots     (nullptr),
+        slot_count(0      )
+    {
+        if (data.size < sizeof(Header)) return;
+
+        Header header;
+
+        std::memcpy (&header, data.data, sizeof(header));
+
+        bool valid = header.magic       == magic
+                  && header.version     == version
+                  && header.slot_count  != 0
+                  && (header.slot_count & (header.slot_count - 1)) == 0
+                  && header.entry_count <= header.slot_count
+                  && sizeof(Header) + size_t(header.slot_count) * sizeof(Entry) <= data.size;
+
+        if (valid)
+        {
+            // zipalign coloca los archivos sin comprimir del APK en direcciones múltiplo de 4, así
+            // que la tabla se puede leer directamente desde la memoria proyectada:
+
+            slots      = reinterpret_cast< const Entry * >(data.data + sizeof(Header));
+            slot_count = header.slot_count;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const Asset_Pack::Entry * Asset_Pack::find (Id id) const
+    {
+        for (uint32_t index = id & (slot_count - 1), probes = 0; probes < slot_count; ++probes, index = (index + 1) & (slot_count - 1))
+        {
+            const Entry & entry = slots[index];
+
+            if (entry.offset == 0) break;
+            if (entry.id     == id) return &entry;
+        }
+
+        return nullptr;
+    }
+
+    const Asset_Pack::Entry * Asset_Pack::find (const std::string & path) const
+    {
+        const Entry * entry = find (get_id (path));
+
+        if (entry && entry->path_offset < data.size)
+        {
+            // Se comprueba la ruta guardada (incluido su caracter nulo) para descartar colisiones:
+
+            const byte * stored_path = data.data + entry->path_offset;
+            size_t       available   = data.size - entry->path_offset;
+
+            if (path.size () < available && std::memcmp (stored_path, path.data (), path.size ()) == 0 && stored_path[path.size ()] == 0)
+            {
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_ptr< Asset > Asset_Pack::open (const Entry & entry) const
+    {
+        if (size_t(entry.offset) + entry.stored_size > data.size)
+        {
+            return std::shared_ptr< Asset >();
+        }
+
+        const byte * payload = data.data + entry.offset;
+
+        if (entry.compression == STORED)
+        {
+            return std::shared_ptr< Asset >(new Memory_Asset(file, { payload, entry.stored_size }));
+        }
+
+        std::vector< byte > decompressed_data(entry.size);
+
+        if (entry.compression == LZ4 && lz4_decompress (payload, entry.stored_size, decompressed_data.data (), decompressed_data.size ()))
+        {
+            return std::shared_ptr< Asset >(new Memory_Asset(decompressed_data));
+        }
+
+        return std::shared_ptr< Asset >();
+    }
+
+}
@@ -0,0 +1,230 @@
+/*
+ * ASSET READER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181640
+ */
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <basics/Asset_Reader>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        typedef std::function< void () > Task;
+
+        /**
+         * Hilo de entrada/salida que ejecuta las tareas en orden. Se crea con la primera lectura
+         * y termina al salir del programa tras completar las tareas pendientes.
+         */
+        class Io_Thread
+        {
+
+            std::mutex                mutex;
+            std::condition_variable   condition;
+            std::deque< Task >        tasks;
+            bool                      stopping;
+            std::thread               thread;
+
+        public:
+
+            std::map< std::string, std::shared_future< Asset_Reader::Result > > prefetched;
+
+        public:
+
+            static Io_Thread & get_instance ()
+            {
+                static Io_Thread instance;
+
+                return instance;
+            }
+
+        public:
+
+            Io_Thread()
+            :
+                stopping(false),
+                thread  (&Io_Thread::run, this)
+            {
+            }
+
+           ~Io_Thread()
+            {
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    stopping = true;
+                }
+
+                condition.notify_one ();
+
+                thread.join ();
+            }
+
+            std::mutex & get_mutex ()
+            {
+                return mutex;
+            }
+
+            /**
+             * Requiere tener el mutex bloqueado (para que encolar y registrar un resultado
+             * precargado sea atómico).
+             */
+            void enqueue (const Task & task)
+            {
+                tasks.push_back (task);
+
+                condition.notify_one ();
+            }
+
+        private:
+
+            void run ()
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                for (;;)
+                {
+                    condition.wait (lock, [this] { return stopping || !tasks.empty (); });
+
+                    if (tasks.empty ()) break;
+
+                    Task task = std::move (tasks.front ());
+
+                    tasks.pop_front ();
+
+                    lock.unlock ();
+
+                    task ();
+
+                    lock.lock ();
+                }
+            }
+
+        };
+
+        /**
+         * Abre el asset y obliga a que su contenido esté en memoria leyendo un byte de cada
+         * página, de forma que quien lo use después no tenga que esperar al almacenamiento.
+         */
+        Asset_Reader::Result load (const std::string & path)
+        {
+            static const size_t page_size = 4096;
+
+            Asset_Reader::Result result{ Asset::open (path), { nullptr, 0 } };
+
+            if (result.asset)
+            {
+                result.data = result.asset->map (Asset::SEQUENTIAL);
+
+                if (result.data.data)
+                {
+                    volatile byte sink = 0;
+
+                    for (size_t offset = 0; offset < result.data.size; offset += page_size)
+                    {
+                        sink ^= result.data.data[offset];
+                    }
+
+                    (void)sink;
+                }
+                else
+                    result.asset.reset ();
+            }
+
+            return result;
+        }
+
+        std::shared_future< Asset_Reader::Result > enqueue_read (Io_Thread & io_thread, const std::string & path)
+        {
+            auto promise = std::make_shared< std::promise< Asset_Reader::Result > > ();
+
+            io_thread.enqueue ([promise, path] { promise->set_value (load (path)); });
+
+            return promise->get_future ().share ();
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_future< Asset_Reader::Result > Asset_Reader::read_async (const std::string & path)
+    {
+        Io_Thread & io_thread = Io_Thread::get_instance ();
+
+        std::lock_guard< std::mutex > lock(io_thread.get_mutex ());
+
+        auto prefetched = io_thread.prefetched.find (path);
+
+        if (prefetched != io_thread.prefetched.end ())
+        {
+            std::shared_future< Result > result = prefetched->second;
+
+            io_thread.prefetched.erase (prefetched);
+
+            return result;
+        }
+
+        return enqueue_read (io_thread, path);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Reader::read_async (const std::string & path, const Callback & callback)
+    {
+        Io_Thread & io_thread = Io_Thread::get_instance ();
+
+        std::lock_guard< std::mutex > lock(io_thread.get_mutex ());
+
+        io_thread.enqueue
+        (
+            [path, callback]
+            {
+                Result result = load (path);
+
+                callback (result);
+            }
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Reader::prefetch (const std::vector< std::string > & paths)
+    {
+        Io_Thread & io_thread = Io_Thread::get_instance ();
+
+        std::lock_guard< std::mutex > lock(io_thread.get_mutex ());
+
+        for (auto & path : paths)
+        {
+            if (io_thread.prefetched.count (path) == 0)
+            {
+                io_thread.prefetched[path] = enqueue_read (io_thread, path);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Reader::discard_prefetched ()
+    {
+        Io_Thread & io_thread = Io_Thread::get_instance ();
+
+        std::lock_guard< std::mutex > lock(io_thread.get_mutex ());
+
+        io_thread.prefetched.clear ();
+    }
+
+}
@@ -0,0 +1,288 @@
+/*
+ * COLOR BUFFER FILTERS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181510
+ */
+
+#include <algorithm>
+#include <basics/Color_Buffer_Filters>
+
+#if   defined(BASICS_NEON_SUPPORTED)
+    #include <arm_neon.h>
+#elif defined(BASICS_SSE2_SUPPORTED)
+    #include <emmintrin.h>
+#endif
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Multiplicación de dos valores de 8 bits dividiendo entre 255 con redondeo exacto:
+
+        inline byte multiply (unsigned a, unsigned b)
+        {
+            unsigned t = a * b + 128;
+
+            return byte((t + (t >> 8)) >> 8);
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void premultiply_alpha (Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        byte   * pixels = color_buffer;
+        unsigned count  = color_buffer.size ();
+        unsigned index  = 0;
+
+        #if defined(BASICS_NEON_SUPPORTED)
+
+            for ( ; index + 16 <= count; index += 16)
+            {
+                uint8x16x4_t rgba = vld4q_u8 (pixels + index * 4);
+
+                for (unsigned component = 0; component < 3; ++component)
+                {
+                    uint16x8_t low  = vmull_u8 (vget_low_u8  (rgba.val[component]), vget_low_u8  (rgba.val[3]));
+                    uint16x8_t high = vmull_u8 (vget_high_u8 (rgba.val[component]), vget_high_u8 (rgba.val[3]));
+
+                    rgba.val[component] = vcombine_u8
+                    (
+                        vrshrn_n_u16 (vrsraq_n_u16 (low,  low,  8), 8),
+                        vrshrn_n_u16 (vrsraq_n_u16 (high, high, 8), 8)
+                    );
+                }
+
+                vst4q_u8 (pixels + index * 4, rgba);
+            }
+
+        #elif defined(BASICS_SSE2_SUPPORTED)
+
+            const __m128i zero        = _mm_setzero_si128 ();
+            const __m128i half        = _mm_set1_epi16    (128);
+            const __m128i alpha_lanes = _mm_set_epi16     (255, 0, 0, 0, 255, 0, 0, 0);
+
+            for ( ; index + 4 <= count; index += 4)
+            {
+                __m128i * address = reinterpret_cast< __m128i * >(pixels + index * 4);
+                __m128i   rgba    = _mm_loadu_si128 (address);
+                __m128i   result[2];
+
+                for (unsigned half_index = 0; half_index < 2; ++half_index)
+                {
+                    __m128i wide  = half_index == 0 ? _mm_unpacklo_epi8 (rgba, zero) : _mm_unpackhi_epi8 (rgba, zero);
+
+                    // El alfa de cada pixel se replica en sus cuatro componentes y en la propia
+                    // componente alfa se multiplica por 255 para que no cambie:
+
+                    __m128i alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (wide, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                    __m128i t     = _mm_add_epi16 (_mm_mullo_epi16 (wide, _mm_or_si128 (alpha, alpha_lanes)), half);
+
+                    result[half_index] = _mm_srli_epi16 (_mm_add_epi16 (t, _mm_srli_epi16 (t, 8)), 8);
+                }
+
+                _mm_storeu_si128 (address, _mm_packus_epi16 (result[0], result[1]));
+            }
+
+        #endif
+
+        for ( ; index < count; ++index)
+        {
+            byte * pixel = pixels + index * 4;
+
+            pixel[0] = multiply (pixel[0], pixel[3]);
+            pixel[1] = multiply (pixel[1], pixel[3]);
+            pixel[2] = multiply (pixel[2], pixel[3]);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void unpremultiply_alpha (Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        byte * pixel = color_buffer;
+        byte * end   = pixel + color_buffer.size () * 4;
+
+        for ( ; pixel < end; pixel += 4)
+        {
+            unsigned alpha = pixel[3];
+
+            if (alpha == 0)
+            {
+                pixel[0] = pixel[1] = pixel[2] = 0;
+            }
+            else
+            if (alpha < 255)
+            {
+                for (unsigned component = 0; component < 3; ++component)
+                {
+                    pixel[component] = byte(std::min (255u, (pixel[component] * 255u + alpha / 2) / alpha));
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void downsample (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba8888 > & destination)
+    {
+        unsigned source_width  = source.width;
+        unsigned source_height = source.height;
+
+        destination.resize (std::max (1u, source_width / 2), std::max (1u, source_height / 2));
+
+        const byte * source_pixels      = reinterpret_cast< const byte * >(source.buffer.data ());
+        byte       * destination_pixels = destination;
+
+        for (unsigned y = 0; y < destination.height; ++y)
+        {
+            const byte * row0 = source_pixels + (std::min (y * 2,     source_height - 1) * source_width) * 4;
+            const byte * row1 = source_pixels + (std::min (y * 2 + 1, source_height - 1) * source_width) * 4;
+            byte       * out  = destination_pixels + y * destination.width * 4;
+            unsigned     x    = 0;
+
+            #if defined(BASICS_NEON_SUPPORTED)
+
+                for ( ; x + 8 <= destination.width && x * 2 + 16 <= source_width; x += 8)
+                {
+                    uint8x16x4_t top    = vld4q_u8 (row0 + x * 8);
+                    uint8x16x4_t bottom = vld4q_u8 (row1 + x * 8);
+                    uint8x8x4_t  result;
+
+                    for (unsigned component = 0; component < 4; ++component)
+                    {
+                        uint16x8_t sum = vpadalq_u8 (vpaddlq_u8 (top.val[component]), bottom.val[component]);
+
+                        result.val[component] = vrshrn_n_u16 (sum, 2);
+                    }
+
+                    vst4_u8 (out + x * 4, result);
+                }
+
+            #elif defined(BASICS_SSE2_SUPPORTED)
+
+                const __m128i zero = _mm_setzero_si128 ();
+                const __m128i two  = _mm_set1_epi16    (2);
+
+                for ( ; x + 2 <= destination.width && x * 2 + 4 <= source_width; x += 2)
+                {
+                    __m128i top    = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(row0 + x * 8));
+                    __m128i bottom = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(row1 + x * 8));
+
+                    // Suma vertical de los cuatro pixels de cada fila y luego suma de cada pareja:
+
+                    __m128i low    = _mm_add_epi16 (_mm_unpacklo_epi8 (top, zero), _mm_unpacklo_epi8 (bottom, zero));
+                    __m128i high   = _mm_add_epi16 (_mm_unpackhi_epi8 (top, zero), _mm_unpackhi_epi8 (bottom, zero));
+                    __m128i sum    = _mm_add_epi16 (_mm_unpacklo_epi64 (low, high), _mm_unpackhi_epi64 (low, high));
+                    __m128i result = _mm_srli_epi16 (_mm_add_epi16 (sum, two), 2);
+
+                    _mm_storel_epi64 (reinterpret_cast< __m128i * >(out + x * 4), _mm_packus_epi16 (result, result));
+                }
+
+            #endif
+
+            for ( ; x < destination.width; ++x)
+            {
+                const unsigned x0 = std::min (x * 2,     source_width - 1) * 4;
+                const unsigned x1 = std::min (x * 2 + 1, source_width - 1) * 4;
+
+                for (unsigned component = 0; component < 4; ++component)
+                {
+                    out[x * 4 + component] = byte
+                    (
+                        (row0[x0 + component] + row0[x1 + component] + row1[x0 + component] + row1[x1 + component] + 2) >> 2
+                    );
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool find_visible_bounds
+    (
+        const Color_Buffer< Rgba8888 > & color_buffer,
+        unsigned & left,
+        unsigned & top,
+        unsigned & width,
+        unsigned & height
+    )
+    {
+        const byte * pixels = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+
+        unsigned min_x = color_buffer.width;
+        unsigned min_y = color_buffer.height;
+        unsigned max_x = 0;
+        unsigned max_y = 0;
+
+        for (unsigned y = 0; y < color_buffer.height; ++y)
+        {
+            const byte * row = pixels + y * color_buffer.width * 4;
+
+            // Solo hace falta buscar el primer y el último pixel visible de cada fila:
+
+            unsigned first = 0;
+            unsigned last  = color_buffer.width;
+
+            while (first < last && row[first * 4 + 3] == 0) ++first;
+
+            if (first == last) continue;
+
+            while (row[(last - 1) * 4 + 3] == 0) --last;
+
+            min_x = std::min (min_x, first);
+            max_x = std::max (max_x, last );
+            min_y = std::min (min_y, y    );
+            max_y = y + 1;
+        }
+
+        if (max_y == 0)
+        {
+            left = top = width = height = 0;
+
+            return false;
+        }
+
+        left   = min_x;
+        top    = min_y;
+        width  = max_x - min_x;
+        height = max_y - min_y;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void crop
+    (
+        const Color_Buffer< Rgba8888 > & source,
+        unsigned left,
+        unsigned top,
+        unsigned width,
+        unsigned height,
+        Color_Buffer< Rgba8888 > & destination
+    )
+    {
+        destination.resize (width, height);
+
+        for (unsigned y = 0; y < height; ++y)
+        {
+            std::copy_n
+            (
+                source.buffer.begin () + (top + y) * source.width + left,
+                width,
+                destination.buffer.begin () + y * width
+            );
+        }
+    }
+
+}
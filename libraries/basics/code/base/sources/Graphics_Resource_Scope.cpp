@@ -0,0 +1,58 @@
+/*
+ * GRAPHICS RESOURCE SCOPE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181815
+ */
+
+#include <basics/Graphics_Resource_Scope>
+
+namespace basics
+{
+
+    bool Graphics_Resource_Scope::keep (Graphics_Context::Accessor & context, const std::shared_ptr< Graphics_Resource > & resource)
+    {
+        if (!resource) return false;
+
+        // Un recurso que ya pertenece al ámbito no se vuelve a registrar:
+
+        for (auto & entry : entries)
+        {
+            if (entry.resource == resource) return true;
+        }
+
+        // Todos los contextos de una ventana comparten la misma caché:
+
+        if (!cache) cache = context->get_resource_cache ();
+
+        Entry entry{ resource, cache ? cache->add (resource) : Graphics_Resource_Cache::Handle() };
+
+        entries.push_back (entry);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Graphics_Resource_Scope::release ()
+    {
+        for (auto & entry : entries)
+        {
+            if (cache) cache->remove (entry.cache_handle);
+
+            // Si el hilo de carga todavía lo está subiendo, se finalizará cuando el contexto lo
+            // publique y suelte la última referencia:
+
+            if (!entry.resource->is_loading ()) entry.resource->finalize ();
+        }
+
+        entries.clear ();
+        entries.shrink_to_fit ();
+    }
+
+}
@@ -0,0 +1,346 @@
+/*
+ * JOB SYSTEM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181905
+ */
+
+#include <basics/Job_System>
+
+namespace basics
+{
+
+    constexpr size_t Job_System::cache_line_size;
+    constexpr size_t Job_System::jobs_per_lane;
+    constexpr size_t Job_System::Job::storage_size;
+
+    static_assert ((Job_System::jobs_per_lane & (Job_System::jobs_per_lane - 1)) == 0, "jobs_per_lane must be a power of 2");
+    static_assert (sizeof(Job_System::Job) == 2 * Job_System::cache_line_size, "Job should take two cache lines");
+
+    namespace
+    {
+
+        // Cada hilo recuerda a qué Job_System pertenece y cuál es su lane en él:
+
+        thread_local const Job_System * current_system = nullptr;
+        thread_local unsigned           current_lane   = 0;
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Job_System::Deque::push (Job * job)
+    {
+        int64_t b = bottom.load (std::memory_order_relaxed);
+        int64_t t = top   .load (std::memory_order_acquire);
+
+        if (b - t >= int64_t(jobs_per_lane)) return false;
+
+        jobs[b & (jobs_per_lane - 1)].store (job, std::memory_order_relaxed);
+
+        // Quien robe el trabajo verá también lo que se ha escrito en él:
+
+        bottom.store (b + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Job_System::Job * Job_System::Deque::pop ()
+    {
+        int64_t b = bottom.load (std::memory_order_relaxed) - 1;
+
+        bottom.store (b, std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+
+        int64_t t = top.load (std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // Estaba vacía:
+
+            bottom.store (b + 1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        Job * job = jobs[b & (jobs_per_lane - 1)].load (std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            // Era el último, así que puede que alguien lo esté robando a la vez:
+
+            if (!top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+
+            bottom.store (b + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Job_System::Job * Job_System::Deque::steal ()
+    {
+        int64_t t = top.load (std::memory_order_acquire);
+
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+
+        int64_t b = bottom.load (std::memory_order_acquire);
+
+        if (t < b)
+        {
+            Job * job = jobs[t & (jobs_per_lane - 1)].load (std::memory_order_relaxed);
+
+            if (top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Job_System::Job_System(unsigned lane_count)
+    :
+        stopping(false),
+        epoch   (0),
+        sleeping(0)
+    {
+        if (lane_count == 0) lane_count = std::thread::hardware_concurrency ();
+        if (lane_count == 0) lane_count = 1;
+
+        for (unsigned lane = 0; lane < lane_count; ++lane)
+        {
+            lanes.emplace_back (new Lane);
+
+            lanes.back ()->next_steal = (lane + 1) % lane_count;
+        }
+
+        current_system = this;
+        current_lane   = 0;
+
+        for (unsigned lane = 1; lane < lane_count; ++lane)
+        {
+            workers.emplace_back (&Job_System::work, this, lane);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Job_System::~Job_System()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            stopping = true;
+        }
+
+        wake_up.notify_all ();
+
+        for (auto & worker : workers) worker.join ();
+
+        if (current_system == this) current_system = nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int Job_System::get_current_lane () const
+    {
+        return current_system == this ? int(current_lane) : -1;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Job_System::Job * Job_System::allocate ()
+    {
+        assert (current_system == this);
+
+        Lane & lane = *lanes[current_lane];
+
+        for (;;)
+        {
+            // Se saltan los huecos cuyo trabajo sigue en alguna cola, se está ejecutando o espera a
+            // sus hijos (como la raíz de parallel_for()):
+
+            for (size_t attempt = 0; attempt < jobs_per_lane; ++attempt)
+            {
+                Job & job = lane.jobs[lane.next_job++ & (jobs_per_lane - 1)];
+
+                if (job.unfinished.load (std::memory_order_acquire) == 0) return &job;
+            }
+
+            // Si están todos ocupados se ayuda a terminar trabajos hasta que quede alguno libre:
+
+            Job * other = find_job (current_lane);
+
+            if (other)
+            {
+                execute (other);
+            }
+            else
+            {
+                std::this_thread::yield ();
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Job_System::run (Job * job)
+    {
+        assert (current_system == this);
+
+        if (!lanes[current_lane]->deque.push (job))
+        {
+            // Si la cola está llena se ejecuta ya en lugar de reservar más memoria:
+
+            execute (job);
+
+            return;
+        }
+
+        // Si algún hilo está dormido se le despierta. Se comprueba después de cambiar epoch para
+        // que no se pierda el aviso si se está echando a dormir justo ahora (ver work()):
+
+        epoch.fetch_add (1, std::memory_order_seq_cst);
+
+        if (sleeping.load (std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            wake_up.notify_one ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Job_System::wait (Job * job)
+    {
+        assert (current_system == this);
+
+        while (!is_finished (job))
+        {
+            Job * other = find_job (current_lane);
+
+            if (other)
+            {
+                execute (other);
+            }
+            else
+            {
+                std::this_thread::yield ();
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Job_System::Job * Job_System::find_job (unsigned lane_index)
+    {
+        Lane & lane = *lanes[lane_index];
+        Job  * job  = lane.deque.pop ();
+
+        if (job) return job;
+
+        // Se intenta robar empezando por el lane al que se robó la última vez:
+
+        unsigned lane_count = unsigned(lanes.size ());
+
+        for (unsigned attempt = 1; attempt < lane_count; ++attempt)
+        {
+            unsigned victim = (lane.next_steal + attempt - 1) % lane_count;
+
+            if (victim == lane_index) continue;
+
+            job = lanes[victim]->deque.steal ();
+
+            if (job)
+            {
+                lane.next_steal = victim;
+
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Job_System::execute (Job * job)
+    {
+        job->function (*job);
+
+        finish (job);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Job_System::finish (Job * job)
+    {
+        // Cuando termina el último hijo de un trabajo que ya se ha ejecutado, termina también ese
+        // trabajo (y puede que su padre):
+
+        // El padre se lee antes de restar porque, en cuanto unfinished llega a 0, el lane que creó
+        // el trabajo puede reutilizar su hueco:
+
+        while (job)
+        {
+            Job * parent = job->parent;
+
+            if (job->unfinished.fetch_sub (1, std::memory_order_acq_rel) != 1) break;
+
+            job = parent;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Job_System::work (unsigned lane)
+    {
+        current_system = this;
+        current_lane   = lane;
+
+        while (!stopping.load (std::memory_order_relaxed))
+        {
+            uint64_t seen = epoch.load (std::memory_order_seq_cst);
+            Job    * job  = find_job (lane);
+
+            if (job)
+            {
+                execute (job);
+
+                continue;
+            }
+
+            // Sin trabajo: se duerme hasta que se lance otro (si no se ha lanzado mientras buscaba):
+
+            sleeping.fetch_add (1, std::memory_order_seq_cst);
+
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                wake_up.wait (lock, [&] ()
+                {
+                    return stopping.load (std::memory_order_relaxed) || epoch.load (std::memory_order_seq_cst) != seen;
+                });
+            }
+
+            sleeping.fetch_sub (1, std::memory_order_seq_cst);
+        }
+    }
+
+}
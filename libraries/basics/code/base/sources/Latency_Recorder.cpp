@@ -0,0 +1,44 @@
+/*
+ * LATENCY RECORDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181885
+ */
+
+#include <algorithm>
+#include <basics/Latency_Recorder>
+
+namespace basics
+{
+
+    Latency_Recorder::Summary Latency_Recorder::get_summary () const
+    {
+        Summary summary = { 0, total_count, 0.f, 0.f, 0.f, 0.f };
+
+        summary.count = size_t(std::min< uint64_t > (total_count, samples.size ()));
+
+        if (summary.count == 0) return summary;
+
+        // Mientras el búfer no se ha llenado, las latencias válidas son las primeras:
+
+        std::copy_n (samples.begin (), summary.count, sorted.begin ());
+        std::sort   (sorted.begin (), sorted.begin () + summary.count);
+
+        float sum = 0.f;
+
+        for (size_t index = 0; index < summary.count; ++index) sum += sorted[index];
+
+        summary.mean   = sum / summary.count;
+        summary.median = sorted[summary.count / 2];
+        summary.p95    = sorted[summary.count * 95 / 100];
+        summary.max    = sorted[summary.count - 1];
+
+        return summary;
+    }
+
+}
@@ -0,0 +1,279 @@
+/*
+ * PIXEL FORMAT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181410
+ */
+
+#include <cmath>
+#include <basics/Pixel_Format>
+
+#if   defined(BASICS_NEON_SUPPORTED)
+    #include <arm_neon.h>
+#elif defined(BASICS_SSE2_SUPPORTED)
+    #include <emmintrin.h>
+#endif
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const byte bayer_matrix[4][4] =
+        {
+            {  0,  8,  2, 10 },
+            { 12,  4, 14,  6 },
+            {  3, 11,  1,  9 },
+            { 15,  7, 13,  5 },
+        };
+
+        /**
+         * Valores que se suman (con saturación) a cada componente de los pixels de una fila antes
+         * de descartar los bits menos significativos. Sin tramado son la mitad del paso de
+         * cuantización (redondeo). Con tramado dependen de la posición dentro de la matriz de Bayer.
+         * Se guardan intercalados (RGBA) y por planos para que cada implementación use lo que le
+         * convenga. El patrón se repite cada 4 pixels.
+         */
+        struct Row_Bias
+        {
+            byte interleaved[16][4];
+            byte planar     [4][16];
+
+            Row_Bias(const unsigned (& bits)[4], unsigned y, bool dither)
+            {
+                for (unsigned x = 0; x < 16; ++x)
+                {
+                    for (unsigned component = 0; component < 4; ++component)
+                    {
+                        unsigned step = 1u << (8 - bits[component]);
+                        unsigned bias = bits[component] == 0 ? 0 : step >> 1;
+
+                        if (dither && component < 3)
+                        {
+                            bias = (bayer_matrix[y & 3][x & 3] * step) >> 4;
+                        }
+
+                        interleaved[x][component] = planar[component][x] = byte(bias);
+                    }
+                }
+            }
+        };
+
+        inline unsigned saturated_add (unsigned a, unsigned b)
+        {
+            return a + b > 255 ? 255 : a + b;
+        }
+
+        template< unsigned R, unsigned G, unsigned B, unsigned A >
+        inline uint16_t pack (const byte * pixel, const byte * bias)
+        {
+            return uint16_t
+            (
+                (saturated_add (pixel[0], bias[0]) >> (8 - R)) << (G + B + A) |
+                (saturated_add (pixel[1], bias[1]) >> (8 - G)) << (    B + A) |
+                (saturated_add (pixel[2], bias[2]) >> (8 - B)) << (        A) |
+                (saturated_add (pixel[3], bias[3]) >> (8 - A))
+            );
+        }
+
+        /**
+         * Convierte una fila. Las versiones SIMD procesan 16 (NEON) u 8 (SSE2) pixels por
+         * iteración y los pixels sobrantes se convierten uno a uno.
+         */
+        template< unsigned R, unsigned G, unsigned B, unsigned A >
+        void convert_row (const byte * source, uint16_t * destination, unsigned width, const Row_Bias & bias)
+        {
+            unsigned x = 0;
+
+            #if defined(BASICS_NEON_SUPPORTED)
+
+                const uint8x16_t bias_r = vld1q_u8 (bias.planar[0]);
+                const uint8x16_t bias_g = vld1q_u8 (bias.planar[1]);
+                const uint8x16_t bias_b = vld1q_u8 (bias.planar[2]);
+                const uint8x16_t bias_a = vld1q_u8 (bias.planar[3]);
+
+                for ( ; x + 16 <= width; x += 16)
+                {
+                    uint8x16x4_t pixels = vld4q_u8 (source + x * 4);
+
+                    uint8x16_t r = vshrq_n_u8 (vqaddq_u8 (pixels.val[0], bias_r), 8 - R);
+                    uint8x16_t g = vshrq_n_u8 (vqaddq_u8 (pixels.val[1], bias_g), 8 - G);
+                    uint8x16_t b = vshrq_n_u8 (vqaddq_u8 (pixels.val[2], bias_b), 8 - B);
+                    uint8x16_t a = vshrq_n_u8 (vqaddq_u8 (pixels.val[3], bias_a), 8 - A);
+
+                    uint16x8_t low  = vorrq_u16
+                    (
+                        vorrq_u16 (vshlq_n_u16 (vmovl_u8 (vget_low_u8  (r)), G + B + A), vshlq_n_u16 (vmovl_u8 (vget_low_u8  (g)), B + A)),
+                        vorrq_u16 (vshlq_n_u16 (vmovl_u8 (vget_low_u8  (b)),         A),              vmovl_u8 (vget_low_u8  (a))        )
+                    );
+
+                    uint16x8_t high = vorrq_u16
+                    (
+                        vorrq_u16 (vshlq_n_u16 (vmovl_u8 (vget_high_u8 (r)), G + B + A), vshlq_n_u16 (vmovl_u8 (vget_high_u8 (g)), B + A)),
+                        vorrq_u16 (vshlq_n_u16 (vmovl_u8 (vget_high_u8 (b)),         A),              vmovl_u8 (vget_high_u8 (a))        )
+                    );
+
+                    vst1q_u16 (destination + x,     low );
+                    vst1q_u16 (destination + x + 8, high);
+                }
+
+            #elif defined(BASICS_SSE2_SUPPORTED)
+
+                const __m128i bias_rgba = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(bias.interleaved));
+                const __m128i byte_mask = _mm_set1_epi32  (0xFF);
+
+                for ( ; x + 8 <= width; x += 8)
+                {
+                    __m128i packed[2];
+
+                    for (unsigned half = 0; half < 2; ++half)
+                    {
+                        __m128i pixels = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(source + (x + half * 4) * 4));
+
+                        pixels = _mm_adds_epu8 (pixels, bias_rgba);
+
+                        __m128i r = _mm_srli_epi32 (_mm_and_si128 (                 pixels,      byte_mask), 8 - R);
+                        __m128i g = _mm_srli_epi32 (_mm_and_si128 (_mm_srli_epi32 (pixels,  8), byte_mask), 8 - G);
+                        __m128i b = _mm_srli_epi32 (_mm_and_si128 (_mm_srli_epi32 (pixels, 16), byte_mask), 8 - B);
+                        __m128i a = _mm_srli_epi32 (                                pixels, 32 - A         );
+
+                        __m128i value = _mm_or_si128
+                        (
+                            _mm_or_si128 (_mm_slli_epi32 (r, G + B + A), _mm_slli_epi32 (g, B + A)),
+                            _mm_or_si128 (_mm_slli_epi32 (b,         A), a                        )
+                        );
+
+                        // SSE2 solo empaqueta con saturación con signo, así que se extiende el signo
+                        // del bit 15 para que los 16 bits bajos se conserven tal cual:
+
+                        packed[half] = _mm_srai_epi32 (_mm_slli_epi32 (value, 16), 16);
+                    }
+
+                    _mm_storeu_si128 (reinterpret_cast< __m128i * >(destination + x), _mm_packs_epi32 (packed[0], packed[1]));
+                }
+
+            #endif
+
+            for ( ; x < width; ++x)
+            {
+                destination[x] = pack< R, G, B, A > (source + x * 4, bias.interleaved[x & 15]);
+            }
+        }
+
+        template< unsigned R, unsigned G, unsigned B, unsigned A >
+        void convert (const Color_Buffer< Rgba8888 > & source, Color_Buffer< uint16_t > & destination, bool dither)
+        {
+            static const unsigned bits[4] = { R, G, B, A };
+
+            destination.resize (source.width, source.height);
+
+            const byte * source_row      = reinterpret_cast< const byte * >(source.buffer.data ());
+            uint16_t   * destination_row = destination.buffer.data ();
+
+            for (unsigned y = 0; y < source.height; ++y)
+            {
+                convert_row< R, G, B, A > (source_row, destination_row, source.width, Row_Bias(bits, y, dither));
+
+                source_row      += source.width * 4;
+                destination_row += source.width;
+            }
+        }
+
+        /**
+         * Devuelve el valor de 8 bits que se obtiene al expandir una componente redondeada a
+         * la cantidad de bits indicada (replicando los bits altos, como hace la GPU).
+         */
+        inline int quantize (unsigned value, unsigned bits)
+        {
+            unsigned quantized = saturated_add (value, 1u << (7 - bits)) >> (8 - bits);
+            unsigned expanded  = quantized << (8 - bits);
+
+            for (unsigned shift = bits; shift < 8; shift += bits)
+            {
+                expanded |= expanded >> shift;
+            }
+
+            return int(expanded);
+        }
+
+        double get_psnr (const Color_Buffer< Rgba8888 > & color_buffer, const unsigned (& bits)[4])
+        {
+            const byte * pixel = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+            const byte * end   = pixel + color_buffer.size () * 4;
+            double       error = 0.0;
+            size_t       count = 0;
+
+            for ( ; pixel < end; pixel += 4)
+            {
+                if (pixel[3] == 0) continue;
+
+                for (unsigned component = 0; component < 4; ++component)
+                {
+                    if (bits[component] == 0) continue;
+
+                    int difference = quantize (pixel[component], bits[component]) - int(pixel[component]);
+
+                    error += difference * difference;
+                    count++;
+                }
+            }
+
+            return error == 0.0 ? 1000.0 : 10.0 * std::log10 (255.0 * 255.0 * count / error);
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Pixel_Format choose_pixel_format (const Color_Buffer< Rgba8888 > & color_buffer, float minimum_psnr)
+    {
+        bool opaque       = true;
+        bool binary_alpha = true;
+
+        const byte * pixel = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+        const byte * end   = pixel + color_buffer.size () * 4;
+
+        for ( ; pixel < end && binary_alpha; pixel += 4)
+        {
+            if (pixel[3] != 255)
+            {
+                opaque = false;
+
+                if (pixel[3] != 0) binary_alpha = false;
+            }
+        }
+
+        static const unsigned rgb565  [4] = { 5, 6, 5, 0 };
+        static const unsigned rgba5551[4] = { 5, 5, 5, 1 };
+        static const unsigned rgba4444[4] = { 4, 4, 4, 4 };
+
+        Pixel_Format    candidate = opaque ? PIXEL_FORMAT_RGB565   : binary_alpha ? PIXEL_FORMAT_RGBA5551 : PIXEL_FORMAT_RGBA4444;
+        const unsigned (& bits)[4] = opaque ? rgb565               : binary_alpha ? rgba5551              : rgba4444;
+
+        return get_psnr (color_buffer, bits) >= minimum_psnr ? candidate : PIXEL_FORMAT_RGBA8888;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void convert_to_rgb565 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgb565 > & destination, bool dither)
+    {
+        convert< 5, 6, 5, 0 > (source, destination, dither);
+    }
+
+    void convert_to_rgba5551 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba5551 > & destination, bool dither)
+    {
+        convert< 5, 5, 5, 1 > (source, destination, dither);
+    }
+
+    void convert_to_rgba4444 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba4444 > & destination, bool dither)
+    {
+        convert< 4, 4, 4, 4 > (source, destination, dither);
+    }
+
+}
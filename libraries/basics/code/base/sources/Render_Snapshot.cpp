@@ -0,0 +1,43 @@
+/*
+ * RENDER SNAPSHOT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181925
+ */
+
+#include <basics/Render_Snapshot>
+
+namespace basics
+{
+
+    void Render_Snapshot::replay (Canvas & canvas) const
+    {
+        if (reset_canvas) canvas.reset_state ();
+
+        if (clear) canvas.clear ();
+
+        // La opacidad solo se cambia cuando varía entre un sprite y el siguiente:
+
+        float current_opacity = 1.f;
+
+        canvas.set_opacity (current_opacity);
+
+        for (const Sprite & sprite : sprites)
+        {
+            if (sprite.opacity != current_opacity)
+            {
+                canvas.set_opacity (current_opacity = sprite.opacity);
+            }
+
+            canvas.fill_rectangle ({ sprite.x, sprite.y }, { sprite.width, sprite.height }, sprite.texture, sprite.anchor);
+        }
+
+        if (current_opacity != 1.f) canvas.set_opacity (1.f);
+    }
+
+}
@@ -10,6 +10,8 @@
  * C1801161300
  */
 
+#include <basics/Asset_Reader>
+#include <basics/etc_decode>
 #include <basics/png_decode>
 #include <basics/Texture_2D>
 
@@ -20,6 +22,42 @@ namespace basics
     Texture_2D::Factory Texture_2D::texture_2d_specialization_factories[10];
     size_t              Texture_2D::texture_2d_specialization_count;
 
+    Id                             Texture_2D::texture_2d_compressed_specialization_ids      [10];
+    Texture_2D::Compressed_Factory Texture_2D::texture_2d_compressed_specialization_factories[10];
+    size_t                         Texture_2D::texture_2d_compressed_specialization_count;
+
+    namespace
+    {
+
+        bool ends_with (const std::string & string, const std::string & suffix)
+        {
+            return string.size () >= suffix.size () && string.compare (string.size () - suffix.size (), suffix.size (), suffix) == 0;
+        }
+
+        /**
+         * Si kept_asset no es nulo, en él se deja el asset para que la textura lo conserve.
+         */
+        bool load_pkm (const std::string & asset_path, Compressed_Buffer & compressed_buffer, std::shared_ptr< Asset > * kept_asset = nullptr)
+        {
+            Asset_Reader::Result asset = Asset_Reader::read (asset_path);
+
+            if (asset.good () && pkm_decode (asset.data.data, asset.data.size, compressed_buffer))
+            {
+                if (kept_asset) *kept_asset = asset.asset;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        std::string get_alpha_path (const std::string & pkm_path)
+        {
+            return pkm_path.substr (0, pkm_path.size () - 4) + ".alpha.pkm";
+        }
+
+    }
+
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
         Id context_id = context->get_id ();
@@ -35,27 +73,131 @@ namespace basics
         return std::shared_ptr< Texture_2D >();
     }
 
+    std::shared_ptr< Texture_2D > Texture_2D::create
+    (
+        Id                           id,
+        Graphics_Context::Accessor & context,
+        Compressed_Buffer          & compressed_buffer,
+        Compressed_Buffer          * compressed_alpha,
+        const Options              & options
+    )
+    {
+        Id context_id = context->get_id ();
+
+        for (unsigned index = 0; index < texture_2d_compressed_specialization_count; ++index)
+        {
+            if (texture_2d_compressed_specialization_ids[index] == context_id)
+            {
+                return texture_2d_compressed_specialization_factories[index] (id, compressed_buffer, compressed_alpha, options);
+            }
+        }
+
+        return std::shared_ptr< Texture_2D >();
+    }
+
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
     {
-        std::shared_ptr< Asset > asset = Asset::open (asset_path);
+        std::shared_ptr< Texture_2D > texture;
+        Source                        source{ asset_path, nullptr, nullptr };
+        bool                          keep_assets = options.retention == RETAIN_MAPPED_ASSET;
 
-        if (asset)
+        if (ends_with (asset_path, ".pkm"))
         {
-            std::vector< byte >  data;
+            Compressed_Buffer compressed_buffer;
 
-            if (asset->read_all (data))
+            if (load_pkm (asset_path, compressed_buffer, keep_assets ? &source.asset : nullptr))
+            {
+                Texture_2D::Options pkm_options = options;
+                Compressed_Buffer   compressed_alpha;
+                std::string         alpha_path  = get_alpha_path (asset_path);
+
+                pkm_options.width  = compressed_buffer.width;
+                pkm_options.height = compressed_buffer.height;
+
+                if (Asset::exists (alpha_path) && load_pkm (alpha_path, compressed_alpha, keep_assets ? &source.alpha_asset : nullptr))
+                {
+                    texture = Texture_2D::create (id, context, compressed_buffer, &compressed_alpha, pkm_options);
+                }
+                else
+                {
+                    texture = Texture_2D::create (id, context, compressed_buffer, nullptr, pkm_options);
+                }
+            }
+        }
+        else
+        {
+            // El PNG se decodifica directamente desde los datos proyectados en memoria. La lectura
+            // se hace en el hilo de entrada/salida, así que si la ruta se ha precargado con
+            // Asset_Reader::prefetch() no hay que esperar al almacenamiento:
+
+            Asset_Reader::Result asset = Asset_Reader::read (asset_path);
+
+            if (asset.good ())
             {
                 Color_Buffer< Rgba8888 > color_buffer;
-                Texture_2D::Options      options;
+                Texture_2D::Options      png_options = options;
 
-                if (png_decode (data, color_buffer, options.width, options.height))
+                if (png_decode (asset.data.data, asset.data.size, color_buffer, png_options.width, png_options.height))
                 {
-                    return Texture_2D::create (id, context, color_buffer, options);
+                    texture = Texture_2D::create (id, context, color_buffer, png_options);
+
+                    if (keep_assets) source.asset = asset.asset;
                 }
             }
         }
 
-        return std::shared_ptr< Texture_2D >();
+        // El origen se anota antes de que la textura se suba, que es cuando puede descartar la
+        // copia de los pixels:
+
+        if (texture) texture->source = source;
+
+        return texture;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Texture_2D::reload (Color_Buffer< Rgba8888 > & color_buffer, Compressed_Buffer & compressed_buffer, Compressed_Buffer & compressed_alpha) const
+    {
+        const std::string & asset_path = source.asset_path;
+
+        if (asset_path.empty ()) return false;
+
+        if (ends_with (asset_path, ".pkm"))
+        {
+            if (source.asset)
+            {
+                Asset::View data = source.asset->map ();
+
+                if (!pkm_decode (data.data, data.size, compressed_buffer)) return false;
+
+                if (source.alpha_asset)
+                {
+                    Asset::View alpha_data = source.alpha_asset->map ();
+
+                    return pkm_decode (alpha_data.data, alpha_data.size, compressed_alpha);
+                }
+
+                return true;
+            }
+
+            std::string alpha_path = get_alpha_path (asset_path);
+
+            return load_pkm (asset_path, compressed_buffer) && (!Asset::exists (alpha_path) || load_pkm (alpha_path, compressed_alpha));
+        }
+
+        unsigned             image_width, image_height;
+        Asset_Reader::Result asset;
+
+        if (source.asset)
+        {
+            asset = { source.asset, source.asset->map () };
+        }
+        else
+        {
+            asset = Asset_Reader::read (asset_path);
+        }
+
+        return asset.good () && png_decode (asset.data.data, asset.data.size, color_buffer, image_width, image_height);
     }
 
 }
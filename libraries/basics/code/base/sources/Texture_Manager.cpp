@@ -0,0 +1,152 @@
+/*
+ * TEXTURE MANAGER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181825
+ */
+
+#include <vector>
+#include <algorithm>
+#include <basics/Texture_Manager>
+
+namespace basics
+{
+
+    Texture_Manager::Texture_Handle Texture_Manager::acquire
+    (
+        Id id,
+        Graphics_Context::Accessor & context,
+        const std::string & asset_path,
+        const Texture_2D::Options & options
+    )
+    {
+        std::string key   = make_key (asset_path, options);
+        auto        found = entries.find (key);
+
+        if (found != entries.end ())
+        {
+            found->second.last_use = ++clock;
+
+            metrics.hits++;
+
+            return found->second.texture;
+        }
+
+        metrics.misses++;
+
+        Texture_Handle texture = Texture_2D::create (id, context, asset_path, options);
+
+        if (texture)
+        {
+            // Las texturas del gestor se registran en la caché para que se restauren si se
+            // pierde el contexto:
+
+            if (!cache) cache = context->get_resource_cache ();
+
+            entries[key] = Entry{ texture, cache ? cache->add (texture) : Graphics_Resource_Cache::Handle(), ++clock };
+
+            context->add_in_background (texture);
+        }
+
+        return texture;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const Texture_Manager::Metrics & Texture_Manager::get_metrics ()
+    {
+        metrics.textures        = entries.size ();
+        metrics.unused_textures = 0;
+        metrics.unused_bytes    = 0;
+
+        for (auto & entry : entries)
+        {
+            if (is_unused (entry.second))
+            {
+                metrics.unused_textures++;
+                metrics.unused_bytes += get_size (*entry.second.texture);
+            }
+        }
+
+        return metrics;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Texture_Manager::trim (size_t byte_limit)
+    {
+        typedef std::pair< uint64_t, Entry_Map::iterator > Candidate;
+
+        std::vector< Candidate > candidates;
+        size_t                   unused_bytes = 0;
+
+        for (auto entry = entries.begin (); entry != entries.end (); ++entry)
+        {
+            if (is_unused (entry->second))
+            {
+                candidates.push_back ({ entry->second.last_use, entry });
+
+                unused_bytes += get_size (*entry->second.texture);
+            }
+        }
+
+        // Se eliminan primero las que hace más tiempo que no se piden:
+
+        std::sort
+        (
+            candidates.begin (), candidates.end (),
+            [] (const Candidate & a, const Candidate & b) { return a.first < b.first; }
+        );
+
+        for (auto & candidate : candidates)
+        {
+            if (unused_bytes <= byte_limit) break;
+
+            Entry & entry = candidate.second->second;
+
+            unused_bytes -= get_size (*entry.texture);
+
+            if (cache) cache->remove (entry.cache_handle);
+
+            entry.texture->finalize ();
+
+            entries.erase (candidate.second);
+
+            metrics.evictions++;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::string Texture_Manager::make_key (const std::string & asset_path, const Texture_2D::Options & options)
+    {
+        // El tamaño de las opciones no se incluye porque al cargar desde un asset se obtiene de él:
+
+        return asset_path + '|'
+             + std::to_string (int(options.pixel_format))
+             + char('0' + options.dither        )
+             + char('0' + options.mipmaps       )
+             + char('0' + options.trilinear     )
+             + char('0' + options.straight_alpha)
+             + char('0' + options.trim          )
+             + std::to_string (int(options.retention));
+    }
+
+    size_t Texture_Manager::get_size (const Texture_2D & texture)
+    {
+        return texture.get_gpu_memory_size () + texture.get_cpu_memory_size ();
+    }
+
+    bool Texture_Manager::is_unused (const Entry & entry)
+    {
+        // Mientras el hilo de carga la tiene, este también conserva una referencia:
+
+        return entry.texture.use_count () == 1;
+    }
+
+}
@@ -0,0 +1,78 @@
+/*
+ * TOUCH COALESCER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181855
+ */
+
+#include <algorithm>
+#include <basics/Touch_Coalescer>
+
+namespace basics
+{
+
+    constexpr unsigned Touch_Coalescer::history_capacity;
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Touch_Coalescer::push (Event && event)
+    {
+        if (event.kind == Event::TOUCH) received_count++;
+
+        if (event.kind == Event::TOUCH && event.id == ID(touch-moved))
+        {
+            int32_t  pointer_id = event.touch.pointer_id;
+            size_t * open_move  = open_moves.get (pointer_id);
+
+            if (open_move)
+            {
+                // La posición que había pasa al historial. Si está lleno se descarta la más antigua:
+
+                Record       & record = pending[*open_move];
+                Event::Touch & touch  = record.event.touch;
+
+                if (touch.history_size == history_capacity)
+                {
+                    std::copy (record.history + 1, record.history + history_capacity, record.history);
+
+                    touch.history_size--;
+                }
+
+                record.history[touch.history_size++] = { touch.x, touch.y, touch.time };
+
+                touch.x    = event.touch.x;
+                touch.y    = event.touch.y;
+                touch.time = event.touch.time;
+
+                return;
+            }
+
+            open_moves.insert (pointer_id, pending.size ());
+        }
+        else
+        {
+            // Los movimientos posteriores a este evento no se pueden juntar con los anteriores
+            // porque se entregarían antes que él:
+
+            open_moves.clear ();
+        }
+
+        pending.emplace_back ();
+
+        Record & record = pending.back ();
+
+        record.event = std::move (event);
+
+        if (record.event.kind == Event::TOUCH)
+        {
+            record.event.touch.history_size = 0;
+            record.event.touch.history      = nullptr;
+        }
+    }
+
+}
@@ -0,0 +1,150 @@
+/*
+ * TOUCH PREDICTOR
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181865
+ */
+
+#include <chrono>
+#include <algorithm>
+#include <basics/Touch_Predictor>
+
+namespace basics
+{
+
+    constexpr unsigned Touch_Predictor::max_samples;
+
+    // ---------------------------------------------------------------------------------------------
+
+    int64_t Touch_Predictor::get_time ()
+    {
+        // En Android AMotionEvent_getEventTime() usa CLOCK_MONOTONIC, que es el de steady_clock:
+
+        return std::chrono::duration_cast< std::chrono::nanoseconds >
+        (
+            std::chrono::steady_clock::now ().time_since_epoch ()
+        )
+        .count ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Touch_Predictor::handle (const Event & event)
+    {
+        if (event.kind != Event::TOUCH) return;
+
+        int32_t pointer_id = event.touch.pointer_id;
+
+        if (event.id == ID(touch-started))
+        {
+            tracks.erase (pointer_id);
+
+            add_sample (pointer_id, { event.touch.x, event.touch.y, event.touch.time });
+        }
+        else
+        if (event.id == ID(touch-moved))
+        {
+            for (uint32_t index = 0; index < event.touch.history_size; ++index)
+            {
+                add_sample (pointer_id, event.touch.history[index]);
+            }
+
+            add_sample (pointer_id, { event.touch.x, event.touch.y, event.touch.time });
+        }
+        else
+        {
+            tracks.erase (pointer_id);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Touch_Predictor::add_sample (int32_t pointer_id, const Sample & sample)
+    {
+        Track & track = tracks[pointer_id];
+
+        if (track.count > 0)
+        {
+            const Sample & last = track.samples[(track.first + track.count - 1) % max_samples];
+
+            // Las muestras que no avanzan en el tiempo no aportan nada al ajuste (y dividirían
+            // entre cero si fuesen las únicas):
+
+            if (sample.time <= last.time) return;
+        }
+
+        if (track.count < max_samples)
+        {
+            track.samples[(track.first + track.count++) % max_samples] = sample;
+        }
+        else
+        {
+            track.samples[track.first] = sample;
+            track.first = (track.first + 1) % max_samples;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Touch_Predictor::predict (int32_t pointer_id, int64_t time, Sample & prediction) const
+    {
+        const Track * track = tracks.get (pointer_id);
+
+        if (!track || track->count == 0) return false;
+
+        const Sample & last = track->samples[(track->first + track->count - 1) % max_samples];
+
+        prediction = last;
+
+        double age = double(time - last.time) * 1e-9;
+
+        if (track->count < 2 || age > max_sample_age + horizon) return true;
+
+        // Recta de mínimos cuadrados x(t) = x0 + vx * t (igual para y) con t relativo a la última
+        // muestra. Solo se usan las muestras de la ventana:
+
+        double sum_t = 0, sum_tt = 0, sum_x = 0, sum_y = 0, sum_tx = 0, sum_ty = 0;
+        unsigned count = 0;
+
+        for (unsigned index = track->count; index-- > 0; )
+        {
+            const Sample & sample = track->samples[(track->first + index) % max_samples];
+
+            double t = double(sample.time - last.time) * 1e-9;
+
+            if (t < -window && count >= 2) break;
+
+            sum_t  += t;
+            sum_tt += t * t;
+            sum_x  += sample.x;
+            sum_y  += sample.y;
+            sum_tx += t * sample.x;
+            sum_ty += t * sample.y;
+
+            count++;
+        }
+
+        double denominator = count * sum_tt - sum_t * sum_t;
+
+        if (denominator <= 0.0) return true;
+
+        double vx = (count * sum_tx - sum_t * sum_x) / denominator;
+        double vy = (count * sum_ty - sum_t * sum_y) / denominator;
+        double x0 = (sum_x - vx * sum_t) / count;
+        double y0 = (sum_y - vy * sum_t) / count;
+
+        double t  = std::max (0.0, std::min (age, double(horizon)));
+
+        prediction.x    = float(x0 + vx * t);
+        prediction.y    = float(y0 + vy * t);
+        prediction.time = time;
+
+        return true;
+    }
+
+}
@@ -0,0 +1,161 @@
+/*
+ * UPLOAD QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181725
+ */
+
+#include <limits>
+#include <algorithm>
+#include <basics/Timer>
+#include <basics/Upload_Queue>
+
+namespace basics
+{
+
+    void Upload_Queue::push (const std::shared_ptr< Graphics_Resource > & resource, Priority priority)
+    {
+        if (!resource || resource->is_initialized () || resource->is_loading ()) return;
+
+        auto inserted = queued.insert (std::make_pair (Resource_Reference(resource), Queued{ priority, 0 }));
+
+        Queued & entry = inserted.first->second;
+
+        if (inserted.second)
+        {
+            entry.pending_bytes = resource->get_pending_upload_size ();
+
+            metrics.pending_resources      = queued.size ();
+            metrics.pending_bytes         += entry.pending_bytes;
+            metrics.peak_pending_resources = std::max (metrics.peak_pending_resources, metrics.pending_resources);
+        }
+        else
+        {
+            // Si ya está encolado con la misma prioridad o con una mayor no hay que hacer nada:
+
+            if (entry.priority <= priority) return;
+
+            entry.priority = priority;
+        }
+
+        queues[priority].push_back (resource);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Upload_Queue::process ()
+    {
+        upload (budget);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Upload_Queue::flush ()
+    {
+        upload ({ std::numeric_limits< float >::max (), std::numeric_limits< size_t >::max () });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Upload_Queue::clear ()
+    {
+        for (auto & queue : queues) queue.clear ();
+
+        queued.clear ();
+
+        metrics.pending_resources = 0;
+        metrics.pending_bytes     = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Upload_Queue::upload (const Budget & budget)
+    {
+        Timer timer;
+
+        metrics.uploaded_resources = 0;
+        metrics.uploaded_bytes     = 0;
+
+        bool exhausted = false;
+
+        for (unsigned index = 0; index < PRIORITY_COUNT; ++index)
+        {
+            Queue & queue = queues[index];
+
+            while (!queue.empty () && !exhausted)
+            {
+                auto entry = queued.find (queue.front ());
+
+                // Las entradas de los recursos que se han adelantado a una cola anterior (y que
+                // puede que ya se hayan subido) se descartan sin más:
+
+                if (entry == queued.end () || entry->second.priority != Priority(index))
+                {
+                    queue.pop_front ();
+                    continue;
+                }
+
+                std::shared_ptr< Graphics_Resource > resource = queue.front ().lock ();
+
+                // Los recursos que ya no usa nadie o que se han inicializado por otra vía se
+                // descartan sin gastar presupuesto:
+
+                if (!resource || resource->is_initialized ())
+                {
+                    dequeue (queue, entry);
+                    continue;
+                }
+
+                size_t remaining_bytes = budget.bytes - std::min (budget.bytes, metrics.uploaded_bytes);
+                size_t uploaded_bytes  = 0;
+                bool   completed       = resource->initialize_step (std::max (size_t(1), remaining_bytes), uploaded_bytes);
+
+                metrics.uploaded_bytes += uploaded_bytes;
+
+                if (completed)
+                {
+                    metrics.uploaded_resources++;
+                    dequeue (queue, entry);
+                }
+                else
+                if (uploaded_bytes == 0)
+                {
+                    dequeue (queue, entry);         // Ha fallado y no se volverá a intentar.
+                }
+                else
+                {
+                    size_t pending_bytes = resource->get_pending_upload_size ();
+
+                    metrics.pending_bytes       = metrics.pending_bytes - entry->second.pending_bytes + pending_bytes;
+                    entry->second.pending_bytes = pending_bytes;
+
+                    exhausted = true;               // Ha agotado lo que quedaba del presupuesto.
+                }
+
+                exhausted = exhausted
+                         || metrics.uploaded_bytes >= budget.bytes
+                         || timer.get_elapsed_seconds () * 1000.f >= budget.milliseconds;
+            }
+        }
+
+        metrics.milliseconds = timer.get_elapsed_seconds () * 1000.f;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Upload_Queue::dequeue (Queue & queue, Queued_Map::iterator entry)
+    {
+        metrics.pending_bytes -= entry->second.pending_bytes;
+
+        queued.erase (entry);
+        queue.pop_front ();
+
+        metrics.pending_resources = queued.size ();
+    }
+
+}
@@ -0,0 +1,426 @@
+/*
+ * COOKED
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181700
+ */
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <rapidxml.hpp>
+#include <basics/cooked>
+#include <basics/fnv>
+
+using namespace std;
+using namespace rapidxml;
+
+namespace basics { namespace cooked
+{
+
+    const char * const suffix = ".bin";
+
+    namespace
+    {
+
+        const uint32_t atlas_magic = 0x4C544142;                ///< "BATL".
+        const uint32_t  font_magic = 0x544E4642;                ///< "BFNT".
+        const uint32_t     version = 1;
+        const uint32_t  byte_order = 0x01020304;                ///< Se lee distinto si el orden de bytes no coincide.
+
+        // Los datos se copian tal cual están en memoria, así que no deben tener relleno:
+
+        static_assert (sizeof(float) == 4 && sizeof(Slice) == 5 * 4 && sizeof(Glyph) == 7 * 4, "unexpected cooked data layout");
+
+        struct Atlas_Header
+        {
+            uint32_t magic;
+            uint32_t byte_order;
+            uint32_t version;
+            uint32_t slice_count;
+            uint32_t texture_name_size;
+        };
+
+        struct Font_Header
+        {
+            uint32_t magic;
+            uint32_t byte_order;
+            uint32_t version;
+            uint32_t first_code;
+            uint32_t glyph_count;
+            float    line_height;
+            float    base_height;
+            uint32_t name_size;
+            uint32_t texture_name_size;
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        template< typename TYPE >
+        void append (std::vector< byte > & data, const TYPE * items, size_t count)
+        {
+            const byte * bytes = reinterpret_cast< const byte * >(items);
+
+            data.insert (data.end (), bytes, bytes + count * sizeof(TYPE));
+        }
+
+        void append (std::vector< byte > & data, const std::string & text)
+        {
+            data.insert (data.end (), text.begin (), text.end ());
+        }
+
+        /**
+         * Lee secuencialmente de un bloque de memoria comprobando que no se sale de él. Los datos
+         * se copian porque no tienen por qué estar alineados.
+         */
+        class Reader
+        {
+
+            const byte * position;
+            const byte * end;
+
+        public:
+
+            Reader(const byte * data, size_t size) : position(data), end(data + size)
+            {
+            }
+
+            template< typename TYPE >
+            bool read (TYPE * items, size_t count)
+            {
+                // Se divide en lugar de multiplicar para que un count corrupto no desborde:
+
+                if (count > size_t(end - position) / sizeof(TYPE)) return false;
+
+                size_t size = count * sizeof(TYPE);
+
+                if (size > 0) std::memcpy (items, position, size);
+
+                position += size;
+
+                return true;
+            }
+
+            /**
+             * Como read(items, count), pero solo reserva memoria si los datos caben en lo que
+             * queda por leer (el count viene de una cabecera que puede estar corrupta).
+             */
+            template< typename TYPE >
+            bool read (std::vector< TYPE > & items, size_t count)
+            {
+                if (count > size_t(end - position) / sizeof(TYPE)) return false;
+
+                items.resize (count);
+
+                return read (items.data (), count);
+            }
+
+            bool read (std::string & text, size_t size)
+            {
+                if (size > size_t(end - position)) return false;
+
+                text.assign (reinterpret_cast< const char * >(position), size);
+
+                position += size;
+
+                return true;
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        int get_int (xml_node<> * node, const char * name, bool & found)
+        {
+            xml_attribute<> * attribute = node->first_attribute (name);
+
+            if (!attribute)
+            {
+                found = false;
+
+                return 0;
+            }
+
+            return std::atoi (attribute->value ());
+        }
+
+        void parse_dir (xml_node<> * dir_tag, const string & prefix, std::vector< Slice > & slices)
+        {
+            for (xml_node<> * child = dir_tag->first_node (); child; child = child->next_sibling ())
+            {
+                if (child->type () == node_element)
+                {
+                    // Se espera que un tag anidado en "dir" sea otro "dir" o un "spr" y debe tener
+                    // atributo "name" para ser tenido en cuenta:
+
+                    xml_attribute<> * name_attribute = child->first_attribute ("name");
+
+                    if (name_attribute)
+                    {
+                        // Se determina el id del nodo añadiendo al prefijo el nombre propio:
+
+                        string id = prefix + name_attribute->value ();
+
+                        if (child->name () == string("dir"))
+                        {
+                            // Si se trata de un "dir" raíz con un nombre por defecto, se descarta su id.
+                            // En otro caso, se le añade un punto como separador:
+
+                            if (id == "/") id.clear (); else id += ".";
+
+                            parse_dir (child, id, slices);
+                        }
+                        else
+                        if (child->name () == string("spr"))
+                        {
+                            bool  found = true;
+                            Slice slice;
+
+                            slice.id     = fnv32 (id);
+                            slice.x      = float(get_int (child, "x", found));
+                            slice.y      = float(get_int (child, "y", found));
+                            slice.width  = float(get_int (child, "w", found));
+                            slice.height = float(get_int (child, "h", found));
+
+                            if (found) slices.push_back (slice);
+                        }
+                    }
+                }
+            }
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool parse_atlas_xml (std::vector< byte > & xml, Atlas_Data & atlas_data)
+    {
+        // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
+        // final de los datos:
+
+        xml.push_back (0);
+
+        xml_document<> document;
+
+        document.parse< 0 > (reinterpret_cast< char * >(xml.data ()));
+
+        xml_node<>      *  img_tag = document.first_node ("img");
+        xml_attribute<> * name_attribute = img_tag ? img_tag->first_attribute ("name") : nullptr;
+
+        if (!name_attribute) return false;
+
+        atlas_data.texture_name = name_attribute->value ();
+        atlas_data.slices.clear ();
+
+        // Se buscan y parsean todos los tags "dir" anidados dentro de "definitions":
+
+        xml_node<> * definitions_tag = img_tag->first_node ();
+
+        if (definitions_tag && definitions_tag->name () == string("definitions"))
+        {
+            for (xml_node<> * dir_tag = definitions_tag->first_node ("dir"); dir_tag; dir_tag = dir_tag->next_sibling ("dir"))
+            {
+                parse_dir (dir_tag, string(), atlas_data.slices);
+            }
+        }
+
+        // Si hay ids repetidos se conserva el primero, como hace Atlas::add_slice():
+
+        std::stable_sort
+        (
+            atlas_data.slices.begin (),
+            atlas_data.slices.end   (),
+            [] (const Slice & a, const Slice & b) { return a.id < b.id; }
+        );
+
+        atlas_data.slices.erase
+        (
+            std::unique
+            (
+                atlas_data.slices.begin (),
+                atlas_data.slices.end   (),
+                [] (const Slice & a, const Slice & b) { return a.id == b.id; }
+            ),
+            atlas_data.slices.end ()
+        );
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool parse_font_xml (std::vector< byte > & xml, Font_Data & font_data)
+    {
+        xml.push_back (0);
+
+        xml_document<> document;
+
+        document.parse< 0 > (reinterpret_cast< char * >(xml.data ()));
+
+        xml_node<> *   font_tag = document.first_node ("font");
+        xml_node<> *   info_tag = font_tag ? font_tag->first_node ("info"  ) : nullptr;
+        xml_node<> * common_tag = font_tag ? font_tag->first_node ("common") : nullptr;
+        xml_node<> *  chars_tag = font_tag ? font_tag->first_node ("chars" ) : nullptr;
+        xml_node<> *  pages_tag = font_tag ? font_tag->first_node ("pages" ) : nullptr;
+        xml_node<> *   page_tag = pages_tag ? pages_tag->first_node ("page") : nullptr;
+
+        if (!info_tag || !common_tag || !chars_tag || !page_tag) return false;
+
+        xml_attribute<> * file_attribute = page_tag->first_attribute ("file");
+        xml_attribute<> * face_attribute = info_tag->first_attribute ("face");
+
+        if (!file_attribute || !face_attribute) return false;
+
+        font_data.texture_name = file_attribute->value ();
+        font_data.name         = face_attribute->value ();
+
+        // Solo se admiten fuentes con una única página:
+
+        bool found = true;
+        int  pages = get_int (common_tag, "pages", found);
+
+        if (found && pages != 1) return false;
+
+        found = true;
+
+        int line_height = get_int (common_tag, "lineHeight", found);
+        int base        = get_int (common_tag, "base",       found);
+
+        if (!found) return false;
+
+        font_data.line_height = float(line_height);
+        font_data.base_height = float(line_height - base);
+
+        if (!(font_data.line_height > 0 && font_data.base_height < font_data.line_height)) return false;
+
+        // Se leen los caracteres ordenados por código para construir después la tabla:
+
+        std::map< uint32_t, Glyph > glyphs;
+
+        found = true;
+
+        int count = get_int (chars_tag, "count", found);
+
+        for (xml_node<> * char_tag = chars_tag->first_node ("char"); char_tag; char_tag = char_tag->next_sibling ("char"))
+        {
+            bool     complete = true;
+            uint32_t code     = uint32_t(get_int (char_tag, "id", complete));
+            Glyph    glyph;
+
+            glyph.x        = float(get_int (char_tag, "x",        complete));
+            glyph.y        = float(get_int (char_tag, "y",        complete));
+            glyph.width    = float(get_int (char_tag, "width",    complete));
+            glyph.height   = float(get_int (char_tag, "height",   complete));
+            glyph.x_offset = float(get_int (char_tag, "xoffset",  complete));
+            glyph.y_offset = float(get_int (char_tag, "yoffset",  complete));
+            glyph.advance  = float(get_int (char_tag, "xadvance", complete));
+
+            if (!complete || glyph.width <= 0 || glyph.height <= 0 || glyphs.count (code)) return false;
+
+            glyphs[code] = glyph;
+        }
+
+        if (glyphs.empty () || (found && count != 0 && size_t(count) != glyphs.size ())) return false;
+
+        font_data.first_code = glyphs.begin ()->first;
+
+        font_data.glyphs.assign (glyphs.rbegin ()->first - font_data.first_code + 1, Glyph{ 0, 0, 0, 0, 0, 0, 0 });
+
+        for (auto & item : glyphs)
+        {
+            font_data.glyphs[item.first - font_data.first_code] = item.second;
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool read_atlas (const byte * data, size_t size, Atlas_Data & atlas_data)
+    {
+        Reader       reader(data, size);
+        Atlas_Header header;
+
+        if (!reader.read (&header, 1) || header.magic != atlas_magic || header.byte_order != byte_order || header.version != version)
+        {
+            return false;
+        }
+
+        return reader.read (atlas_data.texture_name, header.texture_name_size)
+            && reader.read (atlas_data.slices,       header.slice_count      );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool read_font (const byte * data, size_t size, Font_Data & font_data)
+    {
+        Reader      reader(data, size);
+        Font_Header header;
+
+        if (!reader.read (&header, 1) || header.magic != font_magic || header.byte_order != byte_order || header.version != version)
+        {
+            return false;
+        }
+
+        font_data.first_code  = header.first_code;
+        font_data.line_height = header.line_height;
+        font_data.base_height = header.base_height;
+
+        return reader.read (font_data.name,         header.name_size        )
+            && reader.read (font_data.texture_name, header.texture_name_size)
+            && reader.read (font_data.glyphs,       header.glyph_count      );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void write_atlas (const Atlas_Data & atlas_data, std::vector< byte > & data)
+    {
+        Atlas_Header header
+        {
+            atlas_magic,
+            byte_order,
+            version,
+            uint32_t(atlas_data.slices.size ()),
+            uint32_t(atlas_data.texture_name.size ())
+        };
+
+        data.clear ();
+
+        append (data, &header, 1);
+        append (data, atlas_data.texture_name);
+        append (data, atlas_data.slices.data (), atlas_data.slices.size ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void write_font (const Font_Data & font_data, std::vector< byte > & data)
+    {
+        Font_Header header
+        {
+            font_magic,
+            byte_order,
+            version,
+            font_data.first_code,
+            uint32_t(font_data.glyphs.size ()),
+            font_data.line_height,
+            font_data.base_height,
+            uint32_t(font_data.name.size ()),
+            uint32_t(font_data.texture_name.size ())
+        };
+
+        data.clear ();
+
+        append (data, &header, 1);
+        append (data, font_data.name);
+        append (data, font_data.texture_name);
+        append (data, font_data.glyphs.data (), font_data.glyphs.size ());
+    }
+
+}}
@@ -0,0 +1,221 @@
+/*
+ * LZ4
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181600
+ */
+
+#include <cstring>
+#include <basics/lz4>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Restricciones del formato: las coincidencias tienen al menos 4 bytes, los últimos 5
+        // bytes siempre son literales y la última coincidencia empieza como mínimo 12 bytes antes
+        // del final:
+
+        const size_t minimum_match   = 4;
+        const size_t last_literals   = 5;
+        const size_t match_limit     = 12;
+        const size_t maximum_offset  = 65535;
+        const int    hash_bits       = 12;
+
+        inline uint32_t read_32 (const byte * data)
+        {
+            uint32_t value;
+
+            std::memcpy (&value, data, sizeof(value));
+
+            return value;
+        }
+
+        inline uint32_t hash (uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - hash_bits);
+        }
+
+        inline void write_length (std::vector< byte > & output, size_t length)
+        {
+            for ( ; length >= 255; length -= 255)
+            {
+                output.push_back (255);
+            }
+
+            output.push_back (byte(length));
+        }
+
+        void write_sequence
+        (
+            std::vector< byte > & output,
+            const byte          * literals,
+            size_t                literal_length,
+            size_t                offset,
+            size_t                match_length
+        )
+        {
+            size_t token_literals = literal_length < 15 ? literal_length : 15;
+            size_t token_match    = 0;
+
+            if (match_length > 0)
+            {
+                token_match = match_length - minimum_match < 15 ? match_length - minimum_match : 15;
+            }
+
+            output.push_back (byte(token_literals << 4 | token_match));
+
+            if (literal_length >= 15) write_length (output, literal_length - 15);
+
+            output.insert (output.end (), literals, literals + literal_length);
+
+            if (match_length > 0)
+            {
+                output.push_back (byte(offset     ));
+                output.push_back (byte(offset >> 8));
+
+                if (match_length - minimum_match >= 15) write_length (output, match_length - minimum_match - 15);
+            }
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void lz4_compress (const byte * data, size_t size, std::vector< byte > & compressed_data)
+    {
+        compressed_data.clear ();
+        compressed_data.reserve (size + size / 255 + 16);
+
+        const byte * anchor = data;
+
+        if (size > match_limit)
+        {
+            // Tabla con la última posición en la que se ha visto cada secuencia de 4 bytes:
+
+            std::vector< uint32_t > table(size_t(1) << hash_bits, 0);
+
+            const byte * position    = data + 1;
+            const byte * match_end   = data + size - match_limit;
+            const byte * literal_end = data + size - last_literals;
+
+            while (position < match_end)
+            {
+                uint32_t     sequence  = read_32 (position);
+                uint32_t   & slot      = table[hash (sequence)];
+                const byte * candidate = data + slot;
+
+                slot = uint32_t(position - data);
+
+                if (candidate < position && size_t(position - candidate) <= maximum_offset && read_32 (candidate) == sequence)
+                {
+                    // Se amplía la coincidencia hacia atrás mientras se pueda y luego hacia
+                    // delante sin entrar en la zona de literales del final:
+
+                    while (position > anchor && candidate > data && position[-1] == candidate[-1])
+                    {
+                        --position, --candidate;
+                    }
+
+                    const byte * end = position + minimum_match;
+
+                    while (end < literal_end && *end == candidate[end - position])
+                    {
+                        ++end;
+                    }
+
+                    write_sequence (compressed_data, anchor, size_t(position - anchor), size_t(position - candidate), size_t(end - position));
+
+                    anchor = position = end;
+                }
+                else
+                    ++position;
+            }
+        }
+
+        write_sequence (compressed_data, anchor, size_t(data + size - anchor), 0, 0);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool lz4_decompress (const byte * compressed_data, size_t compressed_size, byte * data, size_t size)
+    {
+        const byte * input      = compressed_data;
+        const byte * input_end  = compressed_data + compressed_size;
+        byte       * output     = data;
+        byte       * output_end = data + size;
+
+        while (input < input_end)
+        {
+            unsigned token          = *input++;
+            size_t   literal_length = token >> 4;
+
+            if (literal_length == 15)
+            {
+                for (byte extra = 255; extra == 255; literal_length += extra)
+                {
+                    if (input == input_end) return false;
+
+                    extra = *input++;
+                }
+            }
+
+            if (literal_length > size_t(input_end - input) || literal_length > size_t(output_end - output))
+            {
+                return false;
+            }
+
+            std::memcpy (output, input, literal_length);
+
+            input  += literal_length;
+            output += literal_length;
+
+            // La última secuencia no tiene coincidencia:
+
+            if (input == input_end) break;
+
+            if (input_end - input < 2) return false;
+
+            size_t offset       = size_t(input[0]) | size_t(input[1]) << 8;
+            size_t match_length = (token & 15);
+
+            input += 2;
+
+            if (match_length == 15)
+            {
+                for (byte extra = 255; extra == 255; match_length += extra)
+                {
+                    if (input == input_end) return false;
+
+                    extra = *input++;
+                }
+            }
+
+            match_length += minimum_match;
+
+            if (offset == 0 || offset > size_t(output - data) || match_length > size_t(output_end - output))
+            {
+                return false;
+            }
+
+            // La copia se hace byte a byte porque el origen y el destino se pueden solapar:
+
+            const byte * match = output - offset;
+
+            for (byte * end = output + match_length; output < end; )
+            {
+                *output++ = *match++;
+            }
+        }
+
+        return output == output_end;
+    }
+
+}
@@ -0,0 +1,53 @@
+/*
+ * ETC DECODE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181200
+ */
+
+#ifndef BASICS_ETC_DECODE_HEADER
+#define BASICS_ETC_DECODE_HEADER
+
+    #include <vector>
+    #include <basics/Color_Buffer>
+    #include <basics/Compressed_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Interpreta un archivo PKM (cabecera de 16 bytes seguida de los bloques) con datos ETC1,
+         * ETC2 RGB o ETC2 RGBA.
+         * @return true si la cabecera es válida y el tamaño de los datos coincide con el esperado.
+         */
+        bool pkm_decode (const byte * encoded_data, size_t encoded_size, Compressed_Buffer & compressed_buffer);
+
+        inline bool pkm_decode (const std::vector< byte > & encoded_data, Compressed_Buffer & compressed_buffer)
+        {
+            return pkm_decode (encoded_data.data (), encoded_data.size (), compressed_buffer);
+        }
+
+        /**
+         * Descomprime en la CPU una imagen ETC1/ETC2. Se usa cuando el contexto gráfico no soporta
+         * el formato o cuando no se dispone de GPU.
+         */
+        bool etc_decode (const Compressed_Buffer & compressed_buffer, Color_Buffer< Rgba8888 > & color_buffer);
+
+        /**
+         * Descomprime una imagen ETC1 junto con otra ETC1 que guarda el alfa en su canal rojo.
+         */
+        bool etc_decode
+        (
+            const Compressed_Buffer  & compressed_buffer,
+            const Compressed_Buffer  & compressed_alpha,
+            Color_Buffer< Rgba8888 > & color_buffer
+        );
+
+    }
+
+#endif
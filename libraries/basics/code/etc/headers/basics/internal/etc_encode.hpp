@@ -0,0 +1,47 @@
+/*
+ * ETC ENCODE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181230
+ */
+
+#ifndef BASICS_ETC_ENCODE_HEADER
+#define BASICS_ETC_ENCODE_HEADER
+
+    #include <vector>
+    #include <basics/Color_Buffer>
+    #include <basics/Compressed_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Comprime una imagen RGBA en el formato indicado. Con ETC1_RGB8 y ETC2_RGB8 se descarta
+         * el alfa. Se usa desde la herramienta de conversión offline, no durante el juego.
+         */
+        bool etc_encode
+        (
+            const Color_Buffer< Rgba8888 > & color_buffer,
+            Compressed_Buffer::Format        format,
+            Compressed_Buffer              & compressed_buffer
+        );
+
+        /**
+         * Genera una imagen ETC1 en la que el canal alfa de la imagen de origen se guarda como gris.
+         * Permite usar ETC1 con alfa en dispositivos que no soportan ETC2.
+         */
+        bool etc_encode_alpha (const Color_Buffer< Rgba8888 > & color_buffer, Compressed_Buffer & compressed_alpha);
+
+        /**
+         * Escribe la cabecera PKM y los bloques en un buffer listo para guardar en un archivo.
+         */
+        bool pkm_encode (const Compressed_Buffer & compressed_buffer, std::vector< byte > & encoded_data);
+
+    }
+
+#endif
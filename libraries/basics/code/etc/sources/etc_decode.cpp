@@ -0,0 +1,356 @@
+/*
+ * ETC DECODE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181200
+ */
+
+#include "etc_tables.hpp"
+#include <basics/etc_decode>
+
+namespace basics
+{
+
+    using namespace internal;
+
+    namespace
+    {
+
+        // Un bloque decodificado se guarda como 16 texels RGBA en orden de filas:
+
+        typedef byte Decoded_Block[4][4][4];
+
+        void set_texel (Decoded_Block & texels, unsigned x, unsigned y, int r, int g, int b)
+        {
+            texels[y][x][0] = byte(etc_clamp (r));
+            texels[y][x][1] = byte(etc_clamp (g));
+            texels[y][x][2] = byte(etc_clamp (b));
+            texels[y][x][3] = 255;
+        }
+
+        // Los índices de pixel están organizados por columnas: el bit menos significativo del
+        // índice del texel (x,y) está en el bit x*4+y y el más significativo 16 bits más arriba.
+
+        unsigned get_pixel_index (uint64_t bits, unsigned x, unsigned y)
+        {
+            unsigned bit = x * 4 + y;
+
+            return unsigned(((bits >> (bit + 16)) & 1) << 1 | ((bits >> bit) & 1));
+        }
+
+        void decode_individual_or_differential (uint64_t bits, const int (& base)[2][3], Decoded_Block & texels)
+        {
+            unsigned table[2] = { unsigned(bits >> 37) & 7, unsigned(bits >> 34) & 7 };
+            bool     flipped  = (bits >> 32) & 1;
+
+            for (unsigned y = 0; y < 4; ++y)
+            {
+                for (unsigned x = 0; x < 4; ++x)
+                {
+                    unsigned   subblock = flipped ? (y >= 2) : (x >= 2);
+                    int        modifier = etc_modifier_table[table[subblock]][get_pixel_index (bits, x, y)];
+                    const int (& color)[3] = base[subblock];
+
+                    set_texel (texels, x, y, color[0] + modifier, color[1] + modifier, color[2] + modifier);
+                }
+            }
+        }
+
+        void decode_paint_colors (uint64_t bits, const int (& paint)[4][3], Decoded_Block & texels)
+        {
+            for (unsigned y = 0; y < 4; ++y)
+            {
+                for (unsigned x = 0; x < 4; ++x)
+                {
+                    const int (& color)[3] = paint[get_pixel_index (bits, x, y)];
+
+                    set_texel (texels, x, y, color[0], color[1], color[2]);
+                }
+            }
+        }
+
+        void decode_t_mode (uint64_t bits, Decoded_Block & texels)
+        {
+            int r1 = etc_extend_4 (int(((bits >> 59) & 0x3) << 2 | ((bits >> 56) & 0x3)));
+            int g1 = etc_extend_4 (int( (bits >> 52) & 0xF));
+            int b1 = etc_extend_4 (int( (bits >> 48) & 0xF));
+            int r2 = etc_extend_4 (int( (bits >> 44) & 0xF));
+            int g2 = etc_extend_4 (int( (bits >> 40) & 0xF));
+            int b2 = etc_extend_4 (int( (bits >> 36) & 0xF));
+            int d  = etc2_distance_table[((bits >> 34) & 0x3) << 1 | ((bits >> 32) & 1)];
+
+            const int paint[4][3] =
+            {
+                { r1,     g1,     b1     },
+                { r2 + d, g2 + d, b2 + d },
+                { r2,     g2,     b2     },
+                { r2 - d, g2 - d, b2 - d },
+            };
+
+            decode_paint_colors (bits, paint, texels);
+        }
+
+        void decode_h_mode (uint64_t bits, Decoded_Block & texels)
+        {
+            int r1 = int( (bits >> 59) & 0xF);
+            int g1 = int(((bits >> 56) & 0x7) << 1 | ((bits >> 52) & 1));
+            int b1 = int(((bits >> 51) & 0x1) << 3 | ((bits >> 47) & 0x7));
+            int r2 = int( (bits >> 43) & 0xF);
+            int g2 = int( (bits >> 39) & 0xF);
+            int b2 = int( (bits >> 35) & 0xF);
+
+            // El bit menos significativo del índice de distancia se deduce del orden de los colores:
+
+            unsigned ordering = (r1 << 8 | g1 << 4 | b1) >= (r2 << 8 | g2 << 4 | b2) ? 1 : 0;
+            int      d        = etc2_distance_table[((bits >> 34) & 1) << 2 | ((bits >> 32) & 1) << 1 | ordering];
+
+            r1 = etc_extend_4 (r1); g1 = etc_extend_4 (g1); b1 = etc_extend_4 (b1);
+            r2 = etc_extend_4 (r2); g2 = etc_extend_4 (g2); b2 = etc_extend_4 (b2);
+
+            const int paint[4][3] =
+            {
+                { r1 + d, g1 + d, b1 + d },
+                { r1 - d, g1 - d, b1 - d },
+                { r2 + d, g2 + d, b2 + d },
+                { r2 - d, g2 - d, b2 - d },
+            };
+
+            decode_paint_colors (bits, paint, texels);
+        }
+
+        void decode_planar_mode (uint64_t bits, Decoded_Block & texels)
+        {
+            int ro = etc_extend_6 (int((bits >> 57) & 0x3F));
+            int go = etc_extend_7 (int(((bits >> 56) & 0x1) << 6 | ((bits >> 49) & 0x3F)));
+            int bo = etc_extend_6 (int(((bits >> 48) & 0x1) << 5 | ((bits >> 43) & 0x3) << 3 | ((bits >> 39) & 0x7)));
+            int rh = etc_extend_6 (int(((bits >> 34) & 0x1F) << 1 | ((bits >> 32) & 0x1)));
+            int gh = etc_extend_7 (int( (bits >> 25) & 0x7F));
+            int bh = etc_extend_6 (int( (bits >> 19) & 0x3F));
+            int rv = etc_extend_6 (int( (bits >> 13) & 0x3F));
+            int gv = etc_extend_7 (int( (bits >>  6) & 0x7F));
+            int bv = etc_extend_6 (int( (bits      ) & 0x3F));
+
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    set_texel
+                    (
+                        texels, unsigned(x), unsigned(y),
+                        (x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2,
+                        (x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2,
+                        (x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2
+                    );
+                }
+            }
+        }
+
+        /**
+         * Decodifica un bloque de color de 64 bits. Si etc2 es false, los desbordamientos del modo
+         * diferencial no se interpretan como modos T, H o planar (no existen en ETC1).
+         */
+        void decode_color_block (const byte * block, bool etc2, Decoded_Block & texels)
+        {
+            uint64_t bits = etc_read_block (block);
+
+            int base[2][3];
+
+            if ((bits >> 33) & 1)
+            {
+                // Modo diferencial: el segundo color es el primero más un delta de 3 bits con signo:
+
+                for (unsigned component = 0; component < 3; ++component)
+                {
+                    unsigned shift = 59 - component * 8;
+                    int      value = int((bits >> shift) & 0x1F);
+                    int      delta = int((bits >> (shift - 3)) & 0x7);
+
+                    if (delta >= 4) delta -= 8;
+
+                    int second = value + delta;
+
+                    if (etc2 && (second < 0 || second > 31))
+                    {
+                        switch (component)
+                        {
+                            case 0:  decode_t_mode      (bits, texels); return;
+                            case 1:  decode_h_mode      (bits, texels); return;
+                            default: decode_planar_mode (bits, texels); return;
+                        }
+                    }
+
+                    base[0][component] = etc_extend_5 (value);
+                    base[1][component] = etc_extend_5 (second & 0x1F);
+                }
+            }
+            else
+            {
+                for (unsigned component = 0; component < 3; ++component)
+                {
+                    unsigned shift = 60 - component * 8;
+
+                    base[0][component] = etc_extend_4 (int((bits >>  shift     ) & 0xF));
+                    base[1][component] = etc_extend_4 (int((bits >> (shift - 4)) & 0xF));
+                }
+            }
+
+            decode_individual_or_differential (bits, base, texels);
+        }
+
+        void decode_alpha_block (const byte * block, Decoded_Block & texels)
+        {
+            uint64_t bits       = etc_read_block (block);
+            int      base       = int((bits >> 56) & 0xFF);
+            int      multiplier = int((bits >> 52) & 0x0F);
+            unsigned table      = unsigned((bits >> 48) & 0x0F);
+
+            for (unsigned x = 0; x < 4; ++x)
+            {
+                for (unsigned y = 0; y < 4; ++y)
+                {
+                    unsigned index = unsigned(bits >> (45 - 3 * (x * 4 + y))) & 0x7;
+
+                    texels[y][x][3] = byte(etc_clamp (base + eac_modifier_table[table][index] * multiplier));
+                }
+            }
+        }
+
+        void store_block (const Decoded_Block & texels, unsigned block_x, unsigned block_y, Color_Buffer< Rgba8888 > & color_buffer)
+        {
+            byte   * pixels = color_buffer;
+            unsigned left   = block_x * 4;
+            unsigned top    = block_y * 4;
+
+            for (unsigned y = 0; y < 4 && top + y < color_buffer.height; ++y)
+            {
+                for (unsigned x = 0; x < 4 && left + x < color_buffer.width; ++x)
+                {
+                    byte * pixel = pixels + ((top + y) * color_buffer.width + left + x) * 4;
+
+                    pixel[0] = texels[y][x][0];
+                    pixel[1] = texels[y][x][1];
+                    pixel[2] = texels[y][x][2];
+                    pixel[3] = texels[y][x][3];
+                }
+            }
+        }
+
+        unsigned read_big_endian_16 (const byte * data)
+        {
+            return unsigned(data[0]) << 8 | data[1];
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool pkm_decode (const byte * encoded_data, size_t encoded_size, Compressed_Buffer & compressed_buffer)
+    {
+        static const size_t header_size = 16;
+
+        if (encoded_size < header_size) return false;
+
+        const byte * header = encoded_data;
+
+        if (header[0] != 'P' || header[1] != 'K' || header[2] != 'M' || header[3] != ' ') return false;
+
+        switch (read_big_endian_16 (header + 6))
+        {
+            case 0:  compressed_buffer.format = Compressed_Buffer::ETC1_RGB8;  break;
+            case 1:  compressed_buffer.format = Compressed_Buffer::ETC2_RGB8;  break;
+            case 3:  compressed_buffer.format = Compressed_Buffer::ETC2_RGBA8; break;
+            default: return false;
+        }
+
+        compressed_buffer.width  = read_big_endian_16 (header + 12);
+        compressed_buffer.height = read_big_endian_16 (header + 14);
+
+        size_t expected_size = size_t(compressed_buffer.get_block_size ())
+                             * compressed_buffer.get_blocks_per_row    ()
+                             * compressed_buffer.get_blocks_per_column ();
+
+        if (compressed_buffer.width == 0 || compressed_buffer.height == 0) return false;
+        if (encoded_size < header_size + expected_size)                    return false;
+
+        compressed_buffer.blocks.assign
+        (
+            encoded_data + header_size,
+            encoded_data + header_size + expected_size
+        );
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool etc_decode (const Compressed_Buffer & compressed_buffer, Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        if (compressed_buffer.size () == 0) return false;
+
+        bool     etc2       = compressed_buffer.format != Compressed_Buffer::ETC1_RGB8;
+        bool     alpha      = compressed_buffer.has_alpha ();
+        unsigned color_skip = alpha ? 8 : 0;
+
+        color_buffer.resize (compressed_buffer.width, compressed_buffer.height);
+
+        for (unsigned block_y = 0; block_y < compressed_buffer.get_blocks_per_column (); ++block_y)
+        {
+            for (unsigned block_x = 0; block_x < compressed_buffer.get_blocks_per_row (); ++block_x)
+            {
+                const byte  * block = compressed_buffer.get_block (block_x, block_y);
+                Decoded_Block texels;
+
+                decode_color_block (block + color_skip, etc2, texels);
+
+                if (alpha) decode_alpha_block (block, texels);
+
+                store_block (texels, block_x, block_y, color_buffer);
+            }
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool etc_decode
+    (
+        const Compressed_Buffer  & compressed_buffer,
+        const Compressed_Buffer  & compressed_alpha,
+        Color_Buffer< Rgba8888 > & color_buffer
+    )
+    {
+        if
+        (
+            compressed_alpha.width  != compressed_buffer.width  ||
+            compressed_alpha.height != compressed_buffer.height ||
+            compressed_alpha.has_alpha ()
+        )
+        {
+            return false;
+        }
+
+        Color_Buffer< Rgba8888 > alpha_buffer;
+
+        if (etc_decode (compressed_buffer, color_buffer) && etc_decode (compressed_alpha, alpha_buffer))
+        {
+            byte       * color = color_buffer;
+            const byte * alpha = alpha_buffer;
+
+            for (unsigned index = 0, size = color_buffer.size (); index < size; ++index)
+            {
+                color[index * 4 + 3] = alpha[index * 4];
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+}
@@ -0,0 +1,416 @@
+/*
+ * ETC ENCODE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181245
+ */
+
+#include "etc_tables.hpp"
+#include <basics/etc_encode>
+#include <climits>
+
+namespace basics
+{
+
+    using namespace internal;
+
+    namespace
+    {
+
+        // Texels de un bloque en orden de filas. Los texels que caen fuera de la imagen repiten el
+        // borde para que no influyan en la elección de los colores base:
+
+        typedef int Source_Block[4][4][4];
+
+        void load_block
+        (
+            const Color_Buffer< Rgba8888 > & color_buffer,
+            unsigned block_x,
+            unsigned block_y,
+            Source_Block & texels
+        )
+        {
+            const byte * pixels = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+
+            for (unsigned y = 0; y < 4; ++y)
+            {
+                unsigned source_y = block_y * 4 + y;
+
+                if (source_y >= color_buffer.height) source_y = color_buffer.height - 1;
+
+                for (unsigned x = 0; x < 4; ++x)
+                {
+                    unsigned source_x = block_x * 4 + x;
+
+                    if (source_x >= color_buffer.width) source_x = color_buffer.width - 1;
+
+                    const byte * pixel = pixels + (source_y * color_buffer.width + source_x) * 4;
+
+                    for (unsigned component = 0; component < 4; ++component)
+                    {
+                        texels[y][x][component] = pixel[component];
+                    }
+                }
+            }
+        }
+
+        bool in_subblock (bool flipped, unsigned subblock, unsigned x, unsigned y)
+        {
+            return (flipped ? (y >= 2) : (x >= 2)) == (subblock == 1);
+        }
+
+        void get_subblock_average (const Source_Block & texels, bool flipped, unsigned subblock, float (& average)[3])
+        {
+            int sum[3] = { 0, 0, 0 };
+
+            for (unsigned y = 0; y < 4; ++y)
+            {
+                for (unsigned x = 0; x < 4; ++x)
+                {
+                    if (in_subblock (flipped, subblock, x, y))
+                    {
+                        sum[0] += texels[y][x][0];
+                        sum[1] += texels[y][x][1];
+                        sum[2] += texels[y][x][2];
+                    }
+                }
+            }
+
+            for (unsigned component = 0; component < 3; ++component)
+            {
+                average[component] = sum[component] / 8.f;
+            }
+        }
+
+        int quantize (float value, int levels)
+        {
+            int quantized = int(value * levels / 255.f + .5f);
+
+            return quantized < 0 ? 0 : quantized > levels ? levels : quantized;
+        }
+
+        /**
+         * Busca la tabla de modificadores que mejor aproxima los texels de un subbloque a partir
+         * de su color base. Devuelve el error cuadrático y escribe los índices en los bits.
+         */
+        int encode_subblock
+        (
+            const Source_Block & texels,
+            bool                 flipped,
+            unsigned             subblock,
+            const int         (& base)[3],
+            unsigned           & best_table,
+            uint32_t           & best_indices
+        )
+        {
+            int best_error = INT_MAX;
+
+            for (unsigned table = 0; table < 8; ++table)
+            {
+                int      error   = 0;
+                uint32_t indices = 0;
+
+                for (unsigned y = 0; y < 4; ++y)
+                {
+                    for (unsigned x = 0; x < 4; ++x)
+                    {
+                        if (!in_subblock (flipped, subblock, x, y)) continue;
+
+                        int      best_pixel_error = INT_MAX;
+                        unsigned best_index       = 0;
+
+                        for (unsigned index = 0; index < 4; ++index)
+                        {
+                            int modifier    = etc_modifier_table[table][index];
+                            int pixel_error = 0;
+
+                            for (unsigned component = 0; component < 3; ++component)
+                            {
+                                int difference = etc_clamp (base[component] + modifier) - texels[y][x][component];
+
+                                pixel_error += difference * difference;
+                            }
+
+                            if (pixel_error < best_pixel_error)
+                            {
+                                best_pixel_error = pixel_error;
+                                best_index       = index;
+                            }
+                        }
+
+                        unsigned bit = x * 4 + y;
+
+                        indices |= uint32_t(best_index >> 1) << (bit + 16) | uint32_t(best_index & 1) << bit;
+                        error   += best_pixel_error;
+                    }
+                }
+
+                if (error < best_error)
+                {
+                    best_error   = error;
+                    best_table   = table;
+                    best_indices = indices;
+                }
+            }
+
+            return best_error;
+        }
+
+        /**
+         * Codifica el color de un bloque en ETC1 (válido también como ETC2 porque el modo diferencial
+         * nunca desborda). Se prueban ambas orientaciones de los subbloques y los modos individual y
+         * diferencial, quedándose con la combinación de menor error.
+         */
+        uint64_t encode_color_block (const Source_Block & texels)
+        {
+            uint64_t best_bits  = 0;
+            int      best_error = INT_MAX;
+
+            for (unsigned flip = 0; flip < 2; ++flip)
+            {
+                float average[2][3];
+
+                get_subblock_average (texels, flip == 1, 0, average[0]);
+                get_subblock_average (texels, flip == 1, 1, average[1]);
+
+                for (unsigned differential = 0; differential < 2; ++differential)
+                {
+                    int      quantized[2][3];
+                    int      base[2][3];
+                    uint64_t bits = uint64_t(differential) << 33 | uint64_t(flip) << 32;
+
+                    bool representable = true;
+
+                    for (unsigned component = 0; component < 3; ++component)
+                    {
+                        unsigned shift = 59 - component * 8;
+
+                        if (differential)
+                        {
+                            quantized[0][component] = quantize (average[0][component], 31);
+                            quantized[1][component] = quantize (average[1][component], 31);
+
+                            int delta = quantized[1][component] - quantized[0][component];
+
+                            if (delta < -4 || delta > 3) { representable = false; break; }
+
+                            bits |= uint64_t(quantized[0][component]) << shift | uint64_t(delta & 7) << (shift - 3);
+
+                            base[0][component] = etc_extend_5 (quantized[0][component]);
+                            base[1][component] = etc_extend_5 (quantized[1][component]);
+                        }
+                        else
+                        {
+                            quantized[0][component] = quantize (average[0][component], 15);
+                            quantized[1][component] = quantize (average[1][component], 15);
+
+                            bits |= uint64_t(quantized[0][component]) << (shift + 1) | uint64_t(quantized[1][component]) << (shift - 3);
+
+                            base[0][component] = etc_extend_4 (quantized[0][component]);
+                            base[1][component] = etc_extend_4 (quantized[1][component]);
+                        }
+                    }
+
+                    if (!representable) continue;
+
+                    unsigned table[2];
+                    uint32_t indices[2];
+
+                    int error = encode_subblock (texels, flip == 1, 0, base[0], table[0], indices[0])
+                              + encode_subblock (texels, flip == 1, 1, base[1], table[1], indices[1]);
+
+                    if (error < best_error)
+                    {
+                        best_error = error;
+                        best_bits  = bits | uint64_t(table[0]) << 37 | uint64_t(table[1]) << 34 | (indices[0] | indices[1]);
+                    }
+                }
+            }
+
+            return best_bits;
+        }
+
+        /**
+         * Codifica el alfa de un bloque con EAC. Para cada tabla se prueban los multiplicadores que
+         * cubren el rango de valores del bloque y unos pocos valores base alrededor del centro.
+         */
+        uint64_t encode_alpha_block (const Source_Block & texels)
+        {
+            int minimum = 255;
+            int maximum = 0;
+
+            for (unsigned y = 0; y < 4; ++y)
+            {
+                for (unsigned x = 0; x < 4; ++x)
+                {
+                    if (texels[y][x][3] < minimum) minimum = texels[y][x][3];
+                    if (texels[y][x][3] > maximum) maximum = texels[y][x][3];
+                }
+            }
+
+            uint64_t best_bits  = 0;
+            int      best_error = INT_MAX;
+
+            for (unsigned table = 0; table < 16 && best_error > 0; ++table)
+            {
+                const int (& modifiers)[8] = eac_modifier_table[table];
+
+                int span       = modifiers[7] - modifiers[3];
+                int multiplier = (maximum - minimum + span - 1) / span;
+
+                for (int m = multiplier - 1; m <= multiplier + 1; ++m)
+                {
+                    if (m < 1 || m > 15) continue;
+
+                    int center = (minimum + maximum + 1) / 2 - (modifiers[7] + modifiers[3]) * m / 2;
+
+                    for (int base = center - 2; base <= center + 2; ++base)
+                    {
+                        if (base < 0 || base > 255) continue;
+
+                        int      error = 0;
+                        uint64_t bits  = uint64_t(base) << 56 | uint64_t(m) << 52 | uint64_t(table) << 48;
+
+                        for (unsigned x = 0; x < 4; ++x)
+                        {
+                            for (unsigned y = 0; y < 4; ++y)
+                            {
+                                int      best_pixel_error = INT_MAX;
+                                unsigned best_index       = 0;
+
+                                for (unsigned index = 0; index < 8; ++index)
+                                {
+                                    int difference  = etc_clamp (base + modifiers[index] * m) - texels[y][x][3];
+                                    int pixel_error = difference * difference;
+
+                                    if (pixel_error < best_pixel_error)
+                                    {
+                                        best_pixel_error = pixel_error;
+                                        best_index       = index;
+                                    }
+                                }
+
+                                bits  |= uint64_t(best_index) << (45 - 3 * (x * 4 + y));
+                                error += best_pixel_error;
+                            }
+                        }
+
+                        if (error < best_error)
+                        {
+                            best_error = error;
+                            best_bits  = bits;
+                        }
+                    }
+                }
+            }
+
+            return best_bits;
+        }
+
+        void write_big_endian_16 (byte * data, unsigned value)
+        {
+            data[0] = byte(value >> 8);
+            data[1] = byte(value & 0xFF);
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool etc_encode
+    (
+        const Color_Buffer< Rgba8888 > & color_buffer,
+        Compressed_Buffer::Format        format,
+        Compressed_Buffer              & compressed_buffer
+    )
+    {
+        if (color_buffer.width == 0 || color_buffer.height == 0) return false;
+
+        compressed_buffer = Compressed_Buffer(format, color_buffer.width, color_buffer.height);
+
+        bool     alpha      = compressed_buffer.has_alpha ();
+        unsigned color_skip = alpha ? 8 : 0;
+
+        for (unsigned block_y = 0; block_y < compressed_buffer.get_blocks_per_column (); ++block_y)
+        {
+            for (unsigned block_x = 0; block_x < compressed_buffer.get_blocks_per_row (); ++block_x)
+            {
+                byte       * block = compressed_buffer.get_block (block_x, block_y);
+                Source_Block texels;
+
+                load_block (color_buffer, block_x, block_y, texels);
+
+                if (alpha) etc_write_block (block, encode_alpha_block (texels));
+
+                etc_write_block (block + color_skip, encode_color_block (texels));
+            }
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool etc_encode_alpha (const Color_Buffer< Rgba8888 > & color_buffer, Compressed_Buffer & compressed_alpha)
+    {
+        Color_Buffer< Rgba8888 > alpha_buffer(color_buffer.width, color_buffer.height);
+
+        const byte * source      = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+        byte       * destination = alpha_buffer;
+
+        for (unsigned index = 0, size = color_buffer.size (); index < size; ++index)
+        {
+            byte alpha = source[index * 4 + 3];
+
+            destination[index * 4 + 0] = alpha;
+            destination[index * 4 + 1] = alpha;
+            destination[index * 4 + 2] = alpha;
+            destination[index * 4 + 3] = 255;
+        }
+
+        return etc_encode (alpha_buffer, Compressed_Buffer::ETC1_RGB8, compressed_alpha);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool pkm_encode (const Compressed_Buffer & compressed_buffer, std::vector< byte > & encoded_data)
+    {
+        static const size_t header_size = 16;
+
+        if (compressed_buffer.size () == 0) return false;
+
+        encoded_data.resize (header_size + compressed_buffer.size ());
+
+        byte * header = encoded_data.data ();
+        bool   etc1   = compressed_buffer.format == Compressed_Buffer::ETC1_RGB8;
+
+        header[0] = 'P';
+        header[1] = 'K';
+        header[2] = 'M';
+        header[3] = ' ';
+        header[4] = etc1 ? '1' : '2';
+        header[5] = '0';
+
+        switch (compressed_buffer.format)
+        {
+            case Compressed_Buffer::ETC1_RGB8:  write_big_endian_16 (header + 6, 0); break;
+            case Compressed_Buffer::ETC2_RGB8:  write_big_endian_16 (header + 6, 1); break;
+            case Compressed_Buffer::ETC2_RGBA8: write_big_endian_16 (header + 6, 3); break;
+        }
+
+        write_big_endian_16 (header +  8, compressed_buffer.get_blocks_per_row    () * 4);
+        write_big_endian_16 (header + 10, compressed_buffer.get_blocks_per_column () * 4);
+        write_big_endian_16 (header + 12, compressed_buffer.width );
+        write_big_endian_16 (header + 14, compressed_buffer.height);
+
+        std::copy (compressed_buffer.blocks.begin (), compressed_buffer.blocks.end (), encoded_data.begin () + header_size);
+
+        return true;
+    }
+
+}
@@ -0,0 +1,98 @@
+/*
+ * ETC TABLES
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181215
+ */
+
+#ifndef BASICS_ETC_TABLES_HEADER
+#define BASICS_ETC_TABLES_HEADER
+
+    #include <basics/types>
+
+    namespace basics { namespace internal
+    {
+
+        // Modificadores de luminancia de ETC1/ETC2 indexados por el codeword de la tabla y por el
+        // índice de pixel (0: +a, 1: +b, 2: -a, 3: -b):
+
+        static const int etc_modifier_table[8][4] =
+        {
+            {  2,   8,  -2,   -8 },
+            {  5,  17,  -5,  -17 },
+            {  9,  29,  -9,  -29 },
+            { 13,  42, -13,  -42 },
+            { 18,  60, -18,  -60 },
+            { 24,  80, -24,  -80 },
+            { 33, 106, -33, -106 },
+            { 47, 183, -47, -183 },
+        };
+
+        // Distancias de los modos T y H de ETC2:
+
+        static const int etc2_distance_table[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+        // Modificadores de EAC (canal alfa de ETC2 RGBA8):
+
+        static const int eac_modifier_table[16][8] =
+        {
+            { -3, -6,  -9, -15, 2, 5, 8, 14 },
+            { -3, -7, -10, -13, 2, 6, 9, 12 },
+            { -2, -5,  -8, -13, 1, 4, 7, 12 },
+            { -2, -4,  -6, -13, 1, 3, 5, 12 },
+            { -3, -6,  -8, -12, 2, 5, 7, 11 },
+            { -3, -7,  -9, -11, 2, 6, 8, 10 },
+            { -4, -7,  -8, -11, 3, 6, 7, 10 },
+            { -3, -5,  -8, -11, 2, 4, 7, 10 },
+            { -2, -6,  -8, -10, 1, 5, 7,  9 },
+            { -2, -5,  -8, -10, 1, 4, 7,  9 },
+            { -2, -4,  -8, -10, 1, 3, 7,  9 },
+            { -2, -5,  -7, -10, 1, 4, 6,  9 },
+            { -3, -4,  -7, -10, 2, 3, 6,  9 },
+            { -1, -2,  -3, -10, 0, 1, 2,  9 },
+            { -4, -6,  -8,  -9, 3, 5, 7,  8 },
+            { -3, -5,  -7,  -9, 2, 4, 6,  8 },
+        };
+
+        // Los bloques se guardan en big endian:
+
+        inline uint64_t etc_read_block (const byte * block)
+        {
+            uint64_t value = 0;
+
+            for (int index = 0; index < 8; ++index)
+            {
+                value = (value << 8) | block[index];
+            }
+
+            return value;
+        }
+
+        inline void etc_write_block (byte * block, uint64_t value)
+        {
+            for (int index = 7; index >= 0; --index)
+            {
+                block[index] = byte(value & 0xFF), value >>= 8;
+            }
+        }
+
+        inline int etc_clamp (int value)
+        {
+            return value < 0 ? 0 : value > 255 ? 255 : value;
+        }
+
+        // Expansión de componentes de 4, 5, 6 y 7 bits a 8 bits:
+
+        inline int etc_extend_4 (int value) { return (value << 4) | value; }
+        inline int etc_extend_5 (int value) { return (value << 3) | (value >> 2); }
+        inline int etc_extend_6 (int value) { return (value << 2) | (value >> 4); }
+        inline int etc_extend_7 (int value) { return (value << 1) | (value >> 6); }
+
+    }}
+
+#endif
@@ -14,10 +14,15 @@
 #define BASICS_DIRECTOR_HEADER
 
     #include <memory>
+    #include <vector>
     #include <basics/declarations>
     #include <basics/Event_Queue>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
+    #include <basics/Latency_Recorder>
+    #include <basics/Render_Thread>
+    #include <basics/Texture_Manager>
+    #include <basics/Touch_Coalescer>
     #include <basics/Window>
 
     namespace basics
@@ -62,13 +67,22 @@
             std::shared_ptr< Scene > current_scene;
             std::shared_ptr< Scene >  target_scene;
 
-            Event_Queue event_queue;
+            Event_Queue     event_queue{ 1024 };               ///< Entrada del usuario (descarta si se llena).
+            Touch_Coalescer touch_coalescer;                   ///< Eventos del fotograma con los toques agrupados.
+
+            Latency_Recorder       touch_latency;              ///< Desde que se toca hasta que se presenta el fotograma.
+            std::vector< int64_t > presented_touch_times;      ///< Tiempos de los toques que verá el fotograma actual.
+            int64_t                latched_touch_time;         ///< Tiempo del toque más reciente pasado a Scene::latch().
+
+            bool                   pipelined_rendering;        ///< true si se dibuja en render_thread.
+            Render_Thread          render_thread;
 
             float surface_width;
             float surface_height;
 
             Graphics_Context_Factory graphics_context_factory;
             Graphics_Resource_Cache  graphics_resource_cache;
+            Texture_Manager          texture_manager;
 
         private:
 
@@ -83,6 +97,39 @@
 
             Graphics_Context::Accessor lock_graphics_context ();
 
+            /**
+             * Texturas compartidas entre escenas. Las que dejan de usarse al cambiar de escena se
+             * conservan mientras quepan en el presupuesto del gestor.
+             */
+            Texture_Manager & get_texture_manager ()
+            {
+                return texture_manager;
+            }
+
+            /**
+             * Latencias entre cada toque y la presentación del primer fotograma que lo ha tenido en
+             * cuenta (en handle() o en latch()).
+             */
+            const Latency_Recorder & get_touch_latency () const
+            {
+                return touch_latency;
+            }
+
+            /**
+             * Activa o desactiva el render en un hilo aparte. Con él activado, los fotogramas de
+             * las escenas que implementan Scene::capture() se dibujan en otro hilo mientras se
+             * simula el siguiente. Los de las demás escenas se siguen dibujando como siempre.
+             */
+            void set_pipelined_rendering (bool enabled)
+            {
+                pipelined_rendering = enabled;
+            }
+
+            bool is_pipelined_rendering () const
+            {
+                return pipelined_rendering;
+            }
+
         public:
 
             void run_scene (const std::shared_ptr< Scene > & new_scene);
@@ -97,11 +144,18 @@
                 event_queue.push (event);
             }
 
+            void handle (Event && event)
+            {
+                event_queue.push (std::move (event));
+            }
+
         private:
 
             void run_kernel ();
+            void finalize_current_scene ();
             bool check_scene ();
             void reset_viewport (Window::Accessor & window);
+            void record_touch_latency (const std::vector< int64_t > & touch_times, int64_t presentation_time);
 
         };
 
@@ -0,0 +1,103 @@
+/*
+ * RENDER THREAD
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181930
+ */
+
+#ifndef BASICS_RENDER_THREAD_HEADER
+#define BASICS_RENDER_THREAD_HEADER
+
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+    #include <basics/Non_Copyable>
+    #include <basics/Render_Snapshot>
+    #include <basics/Window>
+
+    namespace basics
+    {
+
+        /**
+         * Hilo que se queda con el contexto gráfico y dibuja las instantáneas que le pasa el hilo
+         * del juego. Hay dos instantáneas: mientras se dibuja una, el hilo del juego rellena la
+         * otra, de modo que la duración de cada fotograma tiende a la mayor de las dos etapas en
+         * lugar de a su suma.
+         * Todos los métodos públicos se deben llamar desde el hilo del juego.
+         */
+        class Render_Thread : Non_Copyable
+        {
+
+            Render_Snapshot         snapshots[2];
+            int                     back;                   ///< Instantánea que rellena el hilo del juego.
+            int                     queued;                 ///< Instantánea pendiente de dibujar o -1.
+            int                     drawing;                ///< Instantánea que se está dibujando o -1.
+            bool                    exit;
+            bool                    running;
+
+            Window::Handle          window_handle;
+            std::thread             thread;
+            std::mutex              mutex;
+            std::condition_variable condition;
+
+        public:
+
+            Render_Thread() : back(0), queued(-1), drawing(-1), exit(false), running(false)
+            {
+            }
+
+           ~Render_Thread()
+            {
+                stop ();
+            }
+
+        public:
+
+            bool is_running () const
+            {
+                return running;
+            }
+
+            /**
+             * Suelta el contexto gráfico en el hilo que llama y arranca el hilo de render, que lo
+             * hará actual en el suyo al dibujar el primer fotograma. Se puede llamar después de
+             * rellenar la instantánea devuelta por acquire().
+             * @return false si la ventana no tiene un contexto disponible.
+             */
+            bool start (Window::Handle window);
+
+            /**
+             * Espera a que se dibuje el fotograma pendiente (si lo hay), detiene el hilo, vacía las
+             * dos instantáneas y vuelve a hacer actual el contexto gráfico en el hilo que llama. No
+             * hace nada si no se ha arrancado.
+             */
+            void stop ();
+
+            /**
+             * Devuelve la instantánea que se puede rellenar, esperando si hace falta a que el hilo
+             * de render termine de dibujarla. Conserva touch_times y presented_time del fotograma
+             * en el que se usó por última vez hasta que se llame a reset().
+             */
+            Render_Snapshot & acquire ();
+
+            /**
+             * Pasa al hilo de render la instantánea devuelta por acquire(). Si todavía no ha
+             * empezado a dibujar la anterior, espera a que lo haga.
+             */
+            void submit ();
+
+        private:
+
+            void run    ();
+            void render (Render_Snapshot & snapshot);
+
+        };
+
+    }
+
+#endif
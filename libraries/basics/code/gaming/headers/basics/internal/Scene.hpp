@@ -15,6 +15,8 @@
 
     #include <basics/Event>
     #include <basics/Graphics_Context>
+    #include <basics/Graphics_Resource_Scope>
+    #include <basics/Render_Snapshot>
     #include <basics/Size>
 
     namespace basics
@@ -25,12 +27,22 @@
         private:
 
             float frame_duration;
+            bool  late_latch;
+
+        protected:
+
+            /**
+             * Recursos gráficos de la escena. El Director los libera después de llamar a
+             * finalize(), de modo que no sobreviven al cambio de escena.
+             */
+            Graphics_Resource_Scope graphics_resources;
 
         public:
 
             Scene()
             {
                 frame_duration = -1.f;
+                late_latch     = false;
             }
 
             virtual ~Scene() = default;
@@ -46,6 +58,23 @@
             virtual void update     (float time) { }
             virtual void render     (Graphics_Context::Accessor & context) { }
 
+            /**
+             * Si la escena activa el late latch, el Director le pasa aquí justo antes de render() los
+             * toques que han llegado durante update(). Solo debe hacer correcciones baratas que
+             * dependan de la entrada (resaltar un botón, mover un cursor...): los mismos eventos se
+             * volverán a recibir en handle() al empezar el siguiente fotograma.
+             */
+            virtual void latch      (const Event & event) { }
+
+            /**
+             * Con el render en otro hilo (Director::set_pipelined_rendering()) el Director llama a
+             * este método en lugar de a render() para que la escena copie lo que quiere dibujar.
+             * Si devuelve false ese fotograma se dibuja con render() en el hilo del juego. Mientras
+             * devuelva true, la escena no debe usar el contexto gráfico desde handle() ni update()
+             * (los recursos se pueden seguir subiendo con add_in_background()).
+             */
+            virtual bool capture    (Render_Snapshot & snapshot) { return false; }
+
             virtual Size2u get_view_size () = 0;
 
         public:
@@ -60,6 +89,21 @@
                 return frame_duration;
             }
 
+            void enable_late_latch (bool enable)
+            {
+                late_latch = enable;
+            }
+
+            bool is_late_latch_enabled () const
+            {
+                return late_latch;
+            }
+
+            Graphics_Resource_Scope & get_graphics_resources ()
+            {
+                return graphics_resources;
+            }
+
         };
 
     }
@@ -15,6 +15,7 @@
 #include <basics/Log>
 #include <basics/Scene>
 #include <basics/Timer>
+#include <basics/Touch_Predictor>
 #include <basics/Window>
 #include <basics/opengles/Canvas_ES2>
 #include <basics/opengles/Context>
@@ -30,6 +31,10 @@ namespace basics
     {
         kernel.running           = false;
         graphics_context_factory = opengles::Context::create;
+        latched_touch_time       = 0;
+        pipelined_rendering      = false;
+
+        presented_touch_times.reserve (64);
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -91,13 +96,10 @@ namespace basics
 
             if (target_scene)
             {
-                // If the current scene must be replaced, then it is first finalized:
-
-                if (current_scene) current_scene->finalize ();
-
-                // And then possibly destroyed:
+                // If the current scene must be replaced, then it is first finalized and its
+                // graphics resources are released:
 
-                current_scene.reset ();
+                finalize_current_scene ();
 
                 // The new scene is then initialized:
 
@@ -129,6 +131,11 @@ namespace basics
 
             while (application.poll (event))
             {
+                // Los eventos de la aplicación pueden cambiar la ventana o el contexto, así que este
+                // debe estar en el hilo del juego:
+
+                render_thread.stop ();
+
                 switch (event.id)
                 {
                     case Application::Event_Id::RESUME:
@@ -204,9 +211,10 @@ namespace basics
                         {
                             case Window::GOT_FOCUS:             state.focused = true;    break;
                             case Window::LOST_FOCUS:            state.focused = false;   break;
-                            case Window::LOST_GRAPHICS_CONTEXT:                          break;
+                            case Window::LOST_GRAPHICS_CONTEXT: render_thread.stop ();   break;
                             case Window::RESIZED:
-                            case Window::VIEWPORT_RESIZED:      reset_viewport (window); break;
+                            case Window::VIEWPORT_RESIZED:      render_thread.stop ();
+                                                                reset_viewport (window); break;
                         }
                     }
 
@@ -224,44 +232,147 @@ namespace basics
                             float  h_ratio = float(scene_view_size.width ) / surface_width;
                             float  v_ratio = float(scene_view_size.height) / surface_height;
 
-                            while (event_queue.poll (event))
+                            // Los eventos pasan de la cola al agrupador en el orden en el que han
+                            // llegado. Los toques salen agrupados (un touch-moved por puntero como
+                            // mucho entre otros eventos) y sus coordenadas se pasan a las de la escena,
+                            // incluidas las del historial:
+
+                            event_queue.drain ([&] (Event & event)
                             {
-                                switch (event.id)
+                                touch_coalescer.push (std::move (event));
+                            });
+
+                            auto to_scene_coordinates = [&] (Event & event)
+                            {
+                                event.touch.x = event.touch.x * h_ratio;
+                                event.touch.y = (surface_height - event.touch.y) * v_ratio;
+
+                                for (uint32_t index = 0; index < event.touch.history_size; ++index)
                                 {
-                                    case ID(touch-started):
-                                    case ID(touch-moved):
-                                    case ID(touch-ended):
-                                    {
-                                        float x = *event.properties[ID(x)].as< var::Float > ();
-                                        float y = *event.properties[ID(y)].as< var::Float > ();
+                                    Event::Touch_Sample & sample = event.touch.history[index];
 
-                                        event.properties[ID(x)] = x * h_ratio;
-                                        event.properties[ID(y)] = (surface_height - y) * v_ratio;
+                                    sample.x = sample.x * h_ratio;
+                                    sample.y = (surface_height - sample.y) * v_ratio;
+                                }
+                            };
 
-                                        break;
-                                    }
+                            touch_coalescer.dispatch ([&] (Event & event)
+                            {
+                                if (event.kind == Event::TOUCH)
+                                {
+                                    to_scene_coordinates (event);
+
+                                    // Los que ya se pasaron a latch() se presentaron en el fotograma anterior:
+
+                                    if (event.touch.time > latched_touch_time) presented_touch_times.push_back (event.touch.time);
                                 }
 
                                 current_scene->handle (event);
-                            }
+                            });
 
                             current_scene->update (time);
 
-                            Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+                            // Late latch: los toques que han llegado durante update() se le muestran
+                            // a la escena sin retirarlos para que corrija lo que vaya a dibujar. Se
+                            // pasan antes al agrupador, donde esperan al siguiente fotograma en orden
+                            // con los demás eventos:
 
-                            if (graphics_context)
+                            auto late_latch = [&] ()
                             {
-                                if (reset_canvas)
+                                if (current_scene->is_late_latch_enabled ())
                                 {
-                                    Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+                                    event_queue.drain ([&] (Event & event)
+                                    {
+                                        touch_coalescer.push (std::move (event));
+                                    });
 
-                                    if (canvas) canvas->reset_state ();
+                                    touch_coalescer.peek ([&] (Event & event)
+                                    {
+                                        to_scene_coordinates (event);
+
+                                        if (event.touch.time > latched_touch_time)
+                                        {
+                                            presented_touch_times.push_back (event.touch.time);
+
+                                            latched_touch_time = event.touch.time;
+                                        }
+
+                                        current_scene->latch (event);
+                                    });
                                 }
+                            };
 
-                                current_scene->render (graphics_context);
+                            bool latched   = false;
+                            bool submitted = false;
 
-                                graphics_context->flush_and_display ();
+                            if (pipelined_rendering)
+                            {
+                                // Puede que haya que esperar a que el hilo de render termine de dibujar
+                                // la instantánea de hace dos fotogramas, que ya se presentó:
+
+                                Render_Snapshot & snapshot = render_thread.acquire ();
+
+                                record_touch_latency (snapshot.touch_times, snapshot.presented_time);
+
+                                snapshot.reset ();
+
+                                late_latch ();
+
+                                latched = true;
+
+                                if (current_scene->capture (snapshot))
+                                {
+                                    snapshot.reset_canvas = reset_canvas;
+
+                                    snapshot.touch_times.swap (presented_touch_times);
+
+                                    if (render_thread.start (window_handle))
+                                    {
+                                        render_thread.submit ();
+
+                                        submitted = true;
+                                    }
+                                    else
+                                    {
+                                        snapshot.touch_times.swap (presented_touch_times);
+                                    }
+                                }
                             }
+
+                            if (!submitted)
+                            {
+                                // La escena no puede dibujar en otro hilo (o no se ha pedido), así que
+                                // el contexto tiene que volver a este:
+
+                                render_thread.stop ();
+
+                                Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+                                if (graphics_context)
+                                {
+                                    if (reset_canvas)
+                                    {
+                                        Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+
+                                        if (canvas) canvas->reset_state ();
+                                    }
+
+                                    graphics_context->process_uploads ();
+
+                                    if (!latched) late_latch ();
+
+                                    current_scene->render (graphics_context);
+
+                                    graphics_context->flush_and_display ();
+
+                                    // Lo más cerca de la presentación que se puede medir es la vuelta del
+                                    // intercambio de búferes:
+
+                                    record_touch_latency (presented_touch_times, Touch_Predictor::get_time ());
+                                }
+                            }
+
+                            presented_touch_times.clear ();
                         }
                     }
                 }
@@ -271,14 +382,88 @@ namespace basics
         }
         while (!kernel.exit && current_scene);
 
+        finalize_current_scene ();
+
+        kernel.running = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::finalize_current_scene ()
+    {
+        // Las instantáneas apuntan a texturas de la escena, así que se deja de dibujar antes:
+
+        render_thread.stop ();
+
         if (current_scene)
         {
             current_scene->finalize ();
 
+            // Los objetos de la GPU se eliminan con el contexto bloqueado para que no se destruya
+            // mientras tanto. Si ya no existe, con él desaparecieron también los objetos:
+
+            Graphics_Context::Accessor graphics_context = lock_graphics_context ();
+
+            current_scene->get_graphics_resources ().release ();
+
+            // The scene is then possibly destroyed:
+
             current_scene.reset ();
+
+            if (graphics_context.has_context ())
+            {
+                // Las texturas compartidas que ya no usa nadie se conservan si caben en el
+                // presupuesto, por si la siguiente escena las vuelve a pedir:
+
+                texture_manager.trim ();
+
+                const Texture_Manager::Metrics & textures = texture_manager.get_metrics ();
+
+                log.d
+                (
+                    "shared textures: " + std::to_string (textures.textures) +
+                    " (" + std::to_string (textures.unused_textures) + " unused, " +
+                    std::to_string (textures.unused_bytes / 1024) + " KiB), " +
+                    std::to_string (textures.hits) + " hits, " + std::to_string (textures.misses) + " misses, " +
+                    std::to_string (textures.evictions) + " evictions"
+                );
+
+                Latency_Recorder::Summary latency = touch_latency.get_summary ();
+
+                if (latency.count > 0)
+                {
+                    log.d
+                    (
+                        "touch to present latency: " + std::to_string (latency.mean) + " ms mean, " +
+                        std::to_string (latency.median) + " ms median, " + std::to_string (latency.p95) + " ms p95, " +
+                        std::to_string (latency.max) + " ms max (last " + std::to_string (latency.count) + " touches)"
+                    );
+                }
+
+                Graphics_Resource_Report report = graphics_context->get_resource_report ();
+
+                log.d
+                (
+                    "live graphics resources: " + std::to_string (report.resources) +
+                    " (" + std::to_string (report.initialized) + " initialized, " +
+                    std::to_string (report.loading) + " loading, " +
+                    std::to_string (report.gpu_bytes / 1024) + " KiB GPU, " +
+                    std::to_string (report.cpu_bytes / 1024) + " KiB CPU)"
+                );
+            }
         }
+    }
 
-        kernel.running = false;
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::record_touch_latency (const std::vector< int64_t > & touch_times, int64_t presentation_time)
+    {
+        if (presentation_time == 0) return;
+
+        for (int64_t touch_time : touch_times)
+        {
+            if (touch_time > 0) touch_latency.record (presentation_time - touch_time);
+        }
     }
 
     // ---------------------------------------------------------------------------------------------
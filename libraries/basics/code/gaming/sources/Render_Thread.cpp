@@ -0,0 +1,183 @@
+/*
+ * RENDER THREAD
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181935
+ */
+
+#include <basics/Canvas>
+#include <basics/Render_Thread>
+#include <basics/Touch_Predictor>
+
+namespace basics
+{
+
+    bool Render_Thread::start (Window::Handle window)
+    {
+        if (running) return true;
+
+        Window::Accessor window_accessor = window.lock ();
+
+        if (!window_accessor) return false;
+
+        {
+            Graphics_Context::Accessor context = window_accessor->lock_graphics_context ();
+
+            // Un contexto EGL solo puede ser actual en un hilo a la vez:
+
+            if (!context || !context->release_current ()) return false;
+        }
+
+        // back, queued y drawing se conservan: stop() los deja sin fotogramas pendientes y puede que
+        // el hilo del juego ya haya rellenado snapshots[back] antes de llamar a start():
+
+        window_handle = window;
+        exit          = false;
+        running       = true;
+
+        thread = std::thread(&Render_Thread::run, this);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::stop ()
+    {
+        if (!running) return;
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            exit = true;
+        }
+
+        condition.notify_all ();
+
+        thread.join ();
+
+        running = false;
+
+        // Las instantáneas apuntan a texturas de la escena, que puede finalizarse a continuación:
+
+        for (Render_Snapshot & snapshot : snapshots) snapshot.reset ();
+
+        // El hilo de render ha soltado el contexto al terminar:
+
+        Window::Accessor window = window_handle.lock ();
+
+        if (window)
+        {
+            Graphics_Context::Accessor context = window->lock_graphics_context ();
+
+            if (context) context->make_current ();
+        }
+
+        window_handle = Window::Handle();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Render_Snapshot & Render_Thread::acquire ()
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+
+        condition.wait (lock, [this] () { return drawing != back && queued != back; });
+
+        return snapshots[back];
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::submit ()
+    {
+        {
+            std::unique_lock< std::mutex > lock(mutex);
+
+            // Como mucho un fotograma en cola para que el juego no se adelante más de uno al render:
+
+            condition.wait (lock, [this] () { return queued == -1; });
+
+            queued = back;
+            back   = 1 - back;
+        }
+
+        condition.notify_all ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::run ()
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+
+        for (;;)
+        {
+            condition.wait (lock, [this] () { return queued != -1 || exit; });
+
+            // Antes de terminar se dibuja lo que haya pendiente:
+
+            if (queued == -1) break;
+
+            drawing = queued;
+            queued  = -1;
+
+            lock.unlock ();
+            condition.notify_all ();
+
+            render (snapshots[drawing]);
+
+            lock.lock ();
+
+            drawing = -1;
+
+            condition.notify_all ();
+        }
+
+        lock.unlock ();
+
+        Window::Accessor window = window_handle.lock ();
+
+        if (window)
+        {
+            Graphics_Context::Accessor context = window->lock_graphics_context ();
+
+            if (context && context->is_current ()) context->release_current ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::render (Render_Snapshot & snapshot)
+    {
+        Window::Accessor window = window_handle.lock ();
+
+        if (!window) return;
+
+        Graphics_Context::Accessor context = window->lock_graphics_context ();
+
+        if (context && (context->is_current () || context->make_current ()))
+        {
+            context->process_uploads ();
+
+            Canvas * canvas = context->get_renderer< Canvas > (ID(canvas));
+
+            if (!canvas)
+            {
+                canvas = Canvas::create (ID(canvas), context, { snapshot.canvas_size });
+            }
+
+            if (canvas) snapshot.replay (*canvas);
+
+            context->flush_and_display ();
+
+            snapshot.presented_time = Touch_Predictor::get_time ();
+        }
+    }
+
+}
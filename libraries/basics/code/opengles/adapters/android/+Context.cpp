@@ -33,9 +33,13 @@
                     )
                 );
 
-                if (context->is_available () && window->set_graphics_context (context))
+                if (context->is_available () && window->set_graphics_context (context) && context->make_current ())
                 {
-                    return context->make_current ();
+                    // Si se perdió el contexto anterior, se vuelven a subir los recursos de la caché:
+
+                    context->initialize ();
+
+                    return true;
                 }
             }
 
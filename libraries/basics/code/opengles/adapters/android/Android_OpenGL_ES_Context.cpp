@@ -38,6 +38,7 @@
             surface       = EGL_NO_SURFACE;
             context       = EGL_NO_CONTEXT;
             config        = nullptr;
+            loader_tried  = false;
             available     = initialized = native_window && initialize_display () && initialize_surface () && initialize_context ();
             version       = VERSION_2_0;
         }
@@ -64,6 +65,8 @@
 
         void Android_OpenGL_ES_Context::finalize ()
         {
+            stop_loader ();
+
             Graphics_Context::finalize ();
 
             available = false;
@@ -109,6 +112,16 @@
             return false;
         }
 
+        bool Android_OpenGL_ES_Context::release_current ()
+        {
+            if (display != EGL_NO_DISPLAY)
+            {
+                return eglMakeCurrent (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE;
+            }
+
+            return false;
+        }
+
         bool Android_OpenGL_ES_Context::flush_and_display ()
         {
             if (available)
@@ -158,6 +171,91 @@
             }
         }
 
+        bool Android_OpenGL_ES_Context::add_in_background (const std::shared_ptr< Graphics_Resource > & resource)
+        {
+            if (resource && !resource->is_initialized () && !resource->is_loading () && start_loader ())
+            {
+                // Hasta que se publique, el recurso no se considera inicializado en este hilo:
+
+                set_loading (*resource, true);
+
+                if (loader->push (resource))
+                {
+                    track (resource);
+
+                    return true;
+                }
+
+                set_loading (*resource, false);
+            }
+
+            return Graphics_Context::add_in_background (resource);
+        }
+
+        void Android_OpenGL_ES_Context::process_uploads ()
+        {
+            if (loader)
+            {
+                std::vector< Android_OpenGL_ES_Loader::Completed > completed;
+
+                loader->take_completed (completed);
+
+                publish (completed);
+            }
+
+            Graphics_Context::process_uploads ();
+        }
+
+        bool Android_OpenGL_ES_Context::has_pending_uploads () const
+        {
+            return Graphics_Context::has_pending_uploads () || (loader && loader->has_pending ());
+        }
+
+        bool Android_OpenGL_ES_Context::start_loader ()
+        {
+            // Solo se intenta una vez por contexto. Si el dispositivo no admite contextos
+            // compartidos, todo se sube en el hilo principal mediante la cola de subidas:
+
+            if (!loader_tried && available)
+            {
+                loader_tried = true;
+
+                loader.reset (new Android_OpenGL_ES_Loader(display, context));
+
+                if (!loader->is_available ()) loader.reset ();
+            }
+
+            return loader && loader->is_available ();
+        }
+
+        void Android_OpenGL_ES_Context::stop_loader ()
+        {
+            if (loader)
+            {
+                std::vector< Android_OpenGL_ES_Loader::Completed > remaining;
+
+                loader->stop (remaining);
+                loader.reset ();
+
+                for (auto & item : remaining) set_loading (*item.resource, false);
+            }
+
+            loader_tried = false;
+        }
+
+        void Android_OpenGL_ES_Context::publish (std::vector< Android_OpenGL_ES_Loader::Completed > & completed)
+        {
+            for (auto & item : completed)
+            {
+                set_loading (*item.resource, false);
+
+                if (!item.uploaded)
+                {
+                    upload_queue.push (item.resource, Upload_Queue::PRIORITY_NORMAL);
+                }
+            }
+        }
+
         bool Android_OpenGL_ES_Context::initialize_display ()
         {
             display = eglGetDisplay (EGL_DEFAULT_DISPLAY);
@@ -14,9 +14,11 @@
 #define BASICS_ANDROID_OPENGL_ES_CONTEXT_HEADER
 
     #include <atomic>
+    #include <memory>
     #include <EGL/egl.h>
     #include <GLES2/gl2.h>
     #include <basics/opengles/Context>
+    #include "Android_OpenGL_ES_Loader.hpp"
 
     namespace basics { namespace internal
     {
@@ -43,6 +45,9 @@
 			EGLint   		surface_width;
 			EGLint  		surface_height;
 
+            std::unique_ptr< Android_OpenGL_ES_Loader > loader;
+            bool                                        loader_tried;
+
         public:
 
             Android_OpenGL_ES_Context(basics::internal::Native_Window & window, Graphics_Resource_Cache * cache);
@@ -70,6 +75,7 @@
 
             bool is_current () const override;
             bool make_current () override;
+            bool release_current () override;
 
             bool set_sync_swap (bool activated) override;
             bool flush_and_display () override;
@@ -88,8 +94,16 @@
 
             void set_viewport (const Point2u & bottom_left, const Size2u & size) override;
 
+            bool add_in_background (const std::shared_ptr< Graphics_Resource > & resource) override;
+            void process_uploads () override;
+            bool has_pending_uploads () const override;
+
         private:
 
+            bool start_loader ();
+            void stop_loader ();
+            void publish (std::vector< Android_OpenGL_ES_Loader::Completed > & completed);
+
             bool initialize_display ();
             bool initialize_surface ();
             bool initialize_context ();
@@ -0,0 +1,278 @@
+/*
+ * ANDROID OPENGL ES LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181745
+ */
+
+// https://www.khronos.org/registry/EGL/extensions/KHR/EGL_KHR_fence_sync.txt
+// https://www.khronos.org/registry/EGL/sdk/docs/man/html/eglCreatePbufferSurface.xhtml
+
+#include <basics/macros>
+
+#if defined(BASICS_ANDROID_OS)
+
+    #include <cstring>
+    #include <GLES2/gl2.h>
+    #include "Android_OpenGL_ES_Loader.hpp"
+
+    #define  EGL_ATTRIBUTE(ATTRIBUTE, VALUE) ATTRIBUTE, VALUE
+
+    namespace basics { namespace opengles { namespace internal
+    {
+
+        Android_OpenGL_ES_Loader::Android_OpenGL_ES_Loader(EGLDisplay display, EGLContext shared_context)
+        :
+            display         (display       ),
+            surface         (EGL_NO_SURFACE),
+            context         (EGL_NO_CONTEXT),
+            create_sync     (nullptr       ),
+            client_wait_sync(nullptr       ),
+            destroy_sync    (nullptr       ),
+            in_progress     (0             ),
+            exit            (false         ),
+            failed          (false         )
+        {
+            // El contexto de carga no dibuja, pero EGL exige una superficie para activarlo. Se usa
+            // una configuración propia porque la del contexto principal puede no admitir pbuffers:
+
+            const EGLint config_attributes[] =
+            {
+                EGL_ATTRIBUTE( EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT ),
+                EGL_ATTRIBUTE( EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT    ),
+                EGL_NONE
+            };
+
+            const EGLint surface_attributes[] =
+            {
+                EGL_ATTRIBUTE( EGL_WIDTH,  1 ),
+                EGL_ATTRIBUTE( EGL_HEIGHT, 1 ),
+                EGL_NONE
+            };
+
+            const EGLint context_attributes[] =
+            {
+                EGL_ATTRIBUTE( EGL_CONTEXT_CLIENT_VERSION, 2 ),
+                EGL_NONE
+            };
+
+            EGLConfig config;
+            EGLint    number_of_suitable_configurations = 0;
+
+            if
+            (
+                eglChooseConfig (display, config_attributes, &config, 1, &number_of_suitable_configurations) &&
+                number_of_suitable_configurations > 0
+            )
+            {
+                surface = eglCreatePbufferSurface (display, config, surface_attributes);
+
+                if (surface != EGL_NO_SURFACE)
+                {
+                    context = eglCreateContext (display, config, shared_context, context_attributes);
+                }
+            }
+
+            if (context == EGL_NO_CONTEXT)
+            {
+                if (surface != EGL_NO_SURFACE) eglDestroySurface (display, surface);
+
+                surface = EGL_NO_SURFACE;
+
+                return;
+            }
+
+            const char * extensions = eglQueryString (display, EGL_EXTENSIONS);
+
+            if (extensions && std::strstr (extensions, "EGL_KHR_fence_sync"))
+            {
+                create_sync      = reinterpret_cast< PFNEGLCREATESYNCKHRPROC     >(eglGetProcAddress ("eglCreateSyncKHR"    ));
+                client_wait_sync = reinterpret_cast< PFNEGLCLIENTWAITSYNCKHRPROC >(eglGetProcAddress ("eglClientWaitSyncKHR"));
+                destroy_sync     = reinterpret_cast< PFNEGLDESTROYSYNCKHRPROC    >(eglGetProcAddress ("eglDestroySyncKHR"   ));
+
+                if (!create_sync || !client_wait_sync || !destroy_sync) create_sync = nullptr;
+            }
+
+            thread = std::thread(&Android_OpenGL_ES_Loader::run, this);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        Android_OpenGL_ES_Loader::~Android_OpenGL_ES_Loader()
+        {
+            std::vector< Completed > discarded;
+
+            stop (discarded);
+
+            if (context != EGL_NO_CONTEXT) eglDestroyContext (display, context);
+            if (surface != EGL_NO_SURFACE) eglDestroySurface (display, surface);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        bool Android_OpenGL_ES_Loader::push (const std::shared_ptr< Graphics_Resource > & resource)
+        {
+            if (!is_available () || !thread.joinable ()) return false;
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                requests.push_back ({ resource, false, EGL_NO_SYNC_KHR });
+            }
+
+            condition.notify_one ();
+
+            return true;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Android_OpenGL_ES_Loader::take_completed (std::vector< Completed > & output)
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            size_t count = 0;
+
+            for ( ; count < completed.size (); ++count)
+            {
+                Entry & entry = completed[count];
+
+                if (entry.fence != EGL_NO_SYNC_KHR && !is_signaled (entry.fence)) break;
+
+                destroy (entry);
+
+                output.push_back ({ entry.resource, entry.uploaded });
+            }
+
+            completed.erase (completed.begin (), completed.begin () + count);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Android_OpenGL_ES_Loader::stop (std::vector< Completed > & output)
+        {
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                exit = true;
+            }
+
+            condition.notify_all ();
+
+            if (thread.joinable ()) thread.join ();
+
+            // Lo que ya se ha subido se entrega cuando la GPU termina con ello para que nunca se
+            // use a medias. Lo que no se llegó a empezar queda pendiente de subir:
+
+            for (auto & entry : completed)
+            {
+                if (entry.fence != EGL_NO_SYNC_KHR)
+                {
+                    client_wait_sync (display, entry.fence, 0, EGL_FOREVER_KHR);
+                }
+
+                destroy (entry);
+
+                output.push_back ({ entry.resource, entry.uploaded });
+            }
+
+            for (auto & entry : requests)
+            {
+                output.push_back ({ entry.resource, false });
+            }
+
+            completed.clear ();
+            requests .clear ();
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        bool Android_OpenGL_ES_Loader::has_pending () const
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            return !requests.empty () || !completed.empty () || in_progress > 0;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Android_OpenGL_ES_Loader::run ()
+        {
+            if (eglMakeCurrent (display, surface, surface, context) != EGL_TRUE)
+            {
+                failed = true;
+            }
+
+            for (;;)
+            {
+                Entry entry;
+
+                {
+                    std::unique_lock< std::mutex > lock(mutex);
+
+                    condition.wait (lock, [this] () { return exit || !requests.empty (); });
+
+                    if (exit) break;
+
+                    entry = requests.front ();
+
+                    requests.pop_front ();
+
+                    in_progress++;
+                }
+
+                // Si el contexto no se pudo activar, el recurso se devuelve sin subir para que lo
+                // haga el hilo principal:
+
+                entry.uploaded = !failed && entry.resource->initialize ();
+                entry.fence    = EGL_NO_SYNC_KHR;
+
+                if (entry.uploaded)
+                {
+                    if (create_sync) entry.fence = create_sync (display, EGL_SYNC_FENCE_KHR, nullptr);
+
+                    // La barrera debe llegar a la GPU, por lo que hay que vaciar el buffer de
+                    // comandos. Sin barrera se espera aquí a que la GPU termine:
+
+                    if (entry.fence != EGL_NO_SYNC_KHR) glFlush (); else glFinish ();
+                }
+
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    completed.push_back (entry);
+
+                    in_progress--;
+                }
+            }
+
+            eglMakeCurrent (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        bool Android_OpenGL_ES_Loader::is_signaled (EGLSyncKHR fence)
+        {
+            return client_wait_sync (display, fence, 0, 0) == EGL_CONDITION_SATISFIED_KHR;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Android_OpenGL_ES_Loader::destroy (Entry & entry)
+        {
+            if (entry.fence != EGL_NO_SYNC_KHR)
+            {
+                destroy_sync (display, entry.fence);
+
+                entry.fence = EGL_NO_SYNC_KHR;
+            }
+        }
+
+    }}}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * ANDROID OPENGL ES LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181740
+ */
+
+#ifndef BASICS_ANDROID_OPENGL_ES_LOADER_HEADER
+#define BASICS_ANDROID_OPENGL_ES_LOADER_HEADER
+
+    #include <atomic>
+    #include <deque>
+    #include <mutex>
+    #include <memory>
+    #include <thread>
+    #include <vector>
+    #include <condition_variable>
+    #include <EGL/egl.h>
+    #include <EGL/eglext.h>
+    #include <basics/Graphics_Resource>
+    #include <basics/Non_Copyable>
+
+    namespace basics { namespace opengles { namespace internal
+    {
+
+        /**
+         * Hilo que inicializa recursos gráficos con su propio contexto EGL, que comparte texturas
+         * y buffers con el contexto principal. Tras cada recurso se inserta una barrera
+         * (EGL_KHR_fence_sync) y el recurso solo se entrega cuando la GPU la ha superado. Sin
+         * esa extensión se espera con glFinish() en el propio hilo de carga.
+         */
+        class Android_OpenGL_ES_Loader : Non_Copyable
+        {
+        public:
+
+            struct Completed
+            {
+                std::shared_ptr< Graphics_Resource > resource;
+                bool                                 uploaded;      ///< false si hay que subirlo en el hilo principal.
+            };
+
+        private:
+
+            struct Entry
+            {
+                std::shared_ptr< Graphics_Resource > resource;
+                bool                                 uploaded;
+                EGLSyncKHR                           fence;
+            };
+
+            EGLDisplay              display;
+            EGLSurface              surface;
+            EGLContext              context;
+
+            PFNEGLCREATESYNCKHRPROC     create_sync;
+            PFNEGLCLIENTWAITSYNCKHRPROC client_wait_sync;
+            PFNEGLDESTROYSYNCKHRPROC    destroy_sync;
+
+            std::deque < Entry >    requests;
+            std::vector< Entry >    completed;
+            size_t                  in_progress;
+            mutable std::mutex      mutex;
+            std::condition_variable condition;
+            std::thread             thread;
+            bool                    exit;
+            std::atomic< bool >     failed;                     ///< El contexto no se pudo activar en el hilo.
+
+        public:
+
+            /**
+             * Crea el contexto compartido y una superficie pbuffer de 1x1 para poder activarlo.
+             * Si algo falla, is_available() retorna false y no se lanza el hilo.
+             */
+            Android_OpenGL_ES_Loader(EGLDisplay display, EGLContext shared_context);
+
+           ~Android_OpenGL_ES_Loader();
+
+        public:
+
+            bool is_available () const
+            {
+                return context != EGL_NO_CONTEXT && !failed;
+            }
+
+            bool push (const std::shared_ptr< Graphics_Resource > & resource);
+
+            /**
+             * Entrega, en orden, los recursos cuya barrera ya se ha superado. No bloquea.
+             */
+            void take_completed (std::vector< Completed > & output);
+
+            /**
+             * Detiene el hilo y entrega todo lo que tenga, terminado o no.
+             */
+            void stop (std::vector< Completed > & output);
+
+            bool has_pending () const;
+
+        private:
+
+            void run ();
+            bool is_signaled (EGLSyncKHR fence);
+            void destroy (Entry & entry);
+
+        };
+
+    }}}
+
+#endif
@@ -21,15 +21,32 @@
     {
 
         class Shader_Program;
+        class Texture_2D;
 
         class Canvas_ES2 : public basics::Canvas
         {
+        public:
+
+            /**
+             * Contadores que se ponen a cero en cada clear(). El tráfico de texturas es una
+             * estimación: texels del nivel de mipmap que correspondería muestrear en cada quad
+             * multiplicados por los bytes por texel de la textura. Los pixels rasterizados son
+             * el área en pantalla de los quads texturizados (sin descontar solapamientos).
+             */
+            struct Statistics
+            {
+                unsigned textured_quads;
+                float    rasterized_pixels;
+                float    texture_bytes;
+            };
+
         private:
 
             static const char * internal_vertex_shader_f;
             static const char * internal_vertex_shader_t;
             static const char * internal_fragment_shader_f;
             static const char * internal_fragment_shader_t;
+            static const char * internal_fragment_shader_a;
 
         public:
 
@@ -47,11 +64,16 @@
             Size2f size;
             Size2f half_size;
 
+            Size2f pixels_per_unit;                                 ///< Pixels del viewport por unidad del canvas.
+
+            Statistics statistics;
+
             Transformation2f transform;
             Transformation2f projection;
 
             std::shared_ptr< Shader_Program > shader_program_f;
             std::shared_ptr< Shader_Program > shader_program_t;
+            std::shared_ptr< Shader_Program > shader_program_a;     ///< Para texturas con el alfa en una textura aparte.
 
             int  transform_f_id;
             int projection_f_id;
@@ -61,10 +83,18 @@
             int projection_t_id;
             int    sampler_t_id;
             int    opacity_t_id;
+            int straight_alpha_t_id;
+            int  transform_a_id;
+            int projection_a_id;
+            int    opacity_a_id;
 
             unsigned   vertex_position_location_f;
             unsigned   vertex_position_location_t;
             unsigned vertex_texture_uv_location_t;
+            unsigned   vertex_position_location_a;
+            unsigned vertex_texture_uv_location_a;
+
+            bool straight_alpha_t;                                  ///< Valor actual del uniform straight_alpha.
 
         public:
 
@@ -74,6 +104,11 @@
 
             void reset_state     () override;
 
+            const Statistics & get_statistics () const
+            {
+                return statistics;
+            }
+
         public:
 
             void set_size        (const Size2u & size) override;
@@ -98,6 +133,11 @@
             void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
 
+        private:
+
+            void draw_textured_quad      (const Texture_2D * texture, const Point2f * coordinates, const Point2f * texture_uvs);
+            void estimate_texture_traffic (const Texture_2D * texture, const Point2f * coordinates, const Point2f * texture_uvs);
+
         };
 
     }}
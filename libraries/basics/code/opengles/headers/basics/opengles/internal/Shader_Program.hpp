@@ -78,6 +78,8 @@
                 if (initialized)
                 {
                     glDeleteProgram (program_object_id);
+
+                    initialized = false;
                 }
             }
 
@@ -13,8 +13,11 @@
 #ifndef BASICS_OPENGLES_TEXTURE_2D_HEADER
 #define BASICS_OPENGLES_TEXTURE_2D_HEADER
 
+    #include <vector>
     #include <basics/Color_Buffer>
+    #include <basics/Compressed_Buffer>
     #include <basics/Graphics_Resource>
+    #include <basics/Pixel_Format>
     #include <basics/opengles/OpenGL_ES2>
     #include <basics/Texture_2D>
 
@@ -29,12 +32,21 @@
         public:
 
             static std::shared_ptr< basics::Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+            static std::shared_ptr< basics::Texture_2D > create (Id id, Compressed_Buffer & compressed_buffer, Compressed_Buffer * compressed_alpha, const Options & options = {});
+
+            /**
+             * Indica si la GPU acepta directamente bloques en el formato dado (ETC1 mediante la
+             * extensión GL_OES_compressed_ETC1_RGB8_texture y ETC2 con un contexto OpenGL ES 3).
+             * Requiere un contexto activo.
+             */
+            static bool supports (Compressed_Buffer::Format format);
 
         public:
 
             static void enable ()
             {
-                register_factory (ID(opengles2), basics::opengles::Texture_2D::create);
+                register_factory            (ID(opengles2), static_cast< Factory            >(basics::opengles::Texture_2D::create));
+                register_compressed_factory (ID(opengles2), static_cast< Compressed_Factory >(basics::opengles::Texture_2D::create));
             }
 
             static void unuse ()
@@ -44,16 +56,73 @@
 
         private:
 
-            Color_Buffer< Rgba8888 > color_buffer;
-            GLuint texture_object_id;
+            /**
+             * Nivel comprimido con LZ4 que se conserva con RETAIN_COMPRESSED.
+             */
+            struct Retained_Level
+            {
+                unsigned            width;
+                unsigned            height;
+                std::vector< byte > data;
+            };
+
+            typedef std::vector< Color_Buffer< Rgba8888 > > Color_Levels;
+            typedef std::vector< Color_Buffer< uint16_t > > Packed_Levels;
+            typedef std::vector< Retained_Level           > Retained_Levels;
+
+            Options           options;                          ///< Para repetir el procesamiento al restaurar.
+            Color_Levels      color_levels;                     ///< Nivel 0 y, si se piden mipmaps, los siguientes.
+            Packed_Levels     packed_levels;                    ///< Lo mismo cuando se usa un formato de 16 bits.
+            Retained_Levels   retained_levels;
+            Pixel_Format      pixel_format;
+            bool              compressed;                       ///< La imagen original son bloques ETC.
+            Compressed_Buffer compressed_buffer;
+            Compressed_Buffer compressed_alpha;
+            GLuint   texture_object_id;
+            GLuint   alpha_texture_object_id;
+            bool     alpha_plane;
+            bool     trilinear;
+            bool     premultiplied;
+            bool     compressed_upload;                         ///< true si la GPU recibió los bloques ETC.
+            unsigned uploaded_levels;
+            unsigned upload_level;                              ///< Nivel que se está subiendo por partes.
+            unsigned upload_row;                                ///< Primera fila de ese nivel que falta por subir.
+
+            struct Level
+            {
+                unsigned     width;
+                unsigned     height;
+                const byte * pixels;
+            };
 
         public:
 
-            Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
+            /**
+             * El recorte de los bordes transparentes, la conversión a un formato de 16 bits y la
+             * generación de mipmaps se hacen en este momento y solo se conservan los niveles
+             * resultantes.
+             */
+            Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, const Options & options);
+
+            Texture_2D(const Compressed_Buffer & compressed_buffer, const Compressed_Buffer * compressed_alpha, const Options & options)
             :
-                basics::Texture_2D(width, height),
-                color_buffer      (color_buffer )
+                basics::Texture_2D(options.width, options.height),
+                options           (options              ),
+                pixel_format      (PIXEL_FORMAT_RGBA8888),
+                compressed        (true                 ),
+                compressed_buffer (compressed_buffer    ),
+                texture_object_id (0                    ),
+                alpha_plane       (false                ),
+                trilinear         (false                ),
+                premultiplied     (false                ),
+                compressed_upload (false                ),
+                uploaded_levels   (0                    ),
+                upload_level      (0                    ),
+                upload_row        (0                    )
             {
+                if (compressed_alpha) this->compressed_alpha = *compressed_alpha;
+
+                retention = options.retention;
             }
 
             Texture_2D(const Texture_2D & ) = delete;
@@ -69,25 +138,99 @@
 
             bool initialize () override;
 
+            /**
+             * Los niveles sin comprimir se suben por franjas de filas con glTexSubImage2D para
+             * ajustarse al presupuesto. Los bloques ETC se suben de una vez.
+             */
+            bool initialize_step (size_t byte_budget, size_t & uploaded_bytes) override;
+
+            size_t get_pending_upload_size () const override;
+
             void finalize () override
             {
-                if (initialized)
+                if (texture_object_id != 0)
                 {
                     glDeleteTextures (1, &texture_object_id);
+
+                    if (alpha_plane) glDeleteTextures (1, &alpha_texture_object_id);
                 }
+
+                // Se puede volver a inicializar si se recupera el contexto:
+
+                texture_object_id = 0;
+                alpha_plane       = false;
+                initialized       = false;
+                upload_level      = 0;
+                upload_row        = 0;
             }
 
         public:
 
             bool is_usable () const
             {
-                return initialized;
+                return is_initialized ();
+            }
+
+            /**
+             * Si es true, el alfa está en una segunda textura que use() enlaza en la unidad 1
+             * y el Canvas debe dibujar con un shader que lo combine.
+             */
+            bool has_alpha_plane () const
+            {
+                return alpha_plane;
+            }
+
+            Pixel_Format get_pixel_format () const
+            {
+                return pixel_format;
+            }
+
+            /**
+             * Indica si el color de los texels está multiplicado por su alfa.
+             */
+            bool is_premultiplied () const
+            {
+                return premultiplied;
             }
 
+            /**
+             * Cantidad de niveles que se han subido a la GPU (1 si no se usan mipmaps).
+             */
+            unsigned get_mipmap_levels () const
+            {
+                return uploaded_levels;
+            }
+
+            bool is_trilinear () const
+            {
+                return trilinear && uploaded_levels > 1;
+            }
+
+            /**
+             * Bytes que ocupa cada texel en la GPU (medio byte por texel con ETC1/ETC2 RGB).
+             */
+            float get_bytes_per_texel () const;
+
+            size_t get_gpu_memory_size () const override;
+            size_t get_cpu_memory_size () const override;
+
         public:
 
             bool use () const;
 
+        private:
+
+            void   prepare (const Color_Buffer< Rgba8888 > & color_buffer);
+            void   trim_transparent_borders ();
+            void   release_pixels ();
+            bool   restore_pixels ();
+            bool   initialize_compressed ();
+            void   upload_levels (size_t byte_budget, size_t & uploaded_bytes);
+            Level  get_level (unsigned index) const;
+            GLuint create_texture_object (unsigned levels);
+            void   upload (GLint level, const Level & data, unsigned first_row, unsigned row_count);
+            void   upload (const Compressed_Buffer & compressed_buffer);
+
         };
 
     }}
@@ -10,6 +10,8 @@
  * C1801091703
  */
 
+#include <cmath>
+#include <algorithm>
 #include <basics/Transformation>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
@@ -50,20 +52,39 @@ namespace basics { namespace opengles
         "uniform float opacity;"
         "void main()"
         "{"
-            "gl_FragColor = vec4(color, opacity);"
+            "gl_FragColor = vec4(color * opacity, opacity);"
         "}";
 
     const char * Canvas_ES2::internal_fragment_shader_t =
         "precision mediump   float;"
         "uniform   sampler2D sampler;"
         "uniform   float     opacity;"
+        "uniform   float     straight_alpha;"
         "varying   vec2      varying_uv;"
         "void main()"
         "{"
             "vec4 texel   = texture2D (sampler, varying_uv);"
-            "gl_FragColor = vec4(texel.rgb, texel.a * opacity);"
+            "texel.rgb   *= mix (1.0, texel.a, straight_alpha);"
+            "gl_FragColor = texel * opacity;"
         "}";
 
+    const char * Canvas_ES2::internal_fragment_shader_a =
+        "precision mediump   float;"
+        "uniform   sampler2D sampler;"
+        "uniform   sampler2D alpha_sampler;"
+        "uniform   float     opacity;"
+        "varying   vec2      varying_uv;"
+        "void main()"
+        "{"
+            "vec3  color  = texture2D (sampler,       varying_uv).rgb;"
+            "float alpha  = texture2D (alpha_sampler, varying_uv).r;"
+            "gl_FragColor = vec4(color * alpha, alpha) * opacity;"
+        "}";
+
+    // Todos los shaders producen color premultiplicado por el alfa, por lo que se mezcla siempre con
+    // GL_ONE, GL_ONE_MINUS_SRC_ALPHA. Las texturas con alfa sin premultiplicar se premultiplican en
+    // el shader (straight_alpha = 1) y la opacidad se aplica a las cuatro componentes.
+
     static const Point2f normal_texture_uvs[] =
     {
         { 0.f, 1.f },
@@ -107,7 +128,8 @@ namespace basics { namespace opengles
 
     Canvas_ES2::Canvas_ES2(Graphics_Context::Accessor & context, const Size2u & size)
     :
-        size{ float(size.width), float(size.height) }
+        size{ float(size.width), float(size.height) },
+        statistics{ 0, 0.f, 0.f }
     {
         shader_program_f.reset (new Shader_Program);
 
@@ -141,11 +163,37 @@ namespace basics { namespace opengles
             projection_t_id = shader_program_t->get_uniform_id ("projection");
                sampler_t_id = shader_program_t->get_uniform_id ("sampler"   );
                opacity_t_id = shader_program_t->get_uniform_id ("opacity"   );
+        straight_alpha_t_id = shader_program_t->get_uniform_id ("straight_alpha");
 
               vertex_position_location_t = shader_program_t->get_vertex_attribute_id ("vertex_position"  );
             vertex_texture_uv_location_t = shader_program_t->get_vertex_attribute_id ("vertex_texture_uv");
 
             shader_program_t->set_uniform_value (sampler_t_id, 0);
+            shader_program_t->set_uniform_value (straight_alpha_t_id, 0.f);
+
+            straight_alpha_t = false;
+        }
+
+        shader_program_a.reset (new Shader_Program);
+
+        shader_program_a->add (Shader::Source_Code::from_string (internal_vertex_shader_t,   Shader::Source_Code::VERTEX  ));
+        shader_program_a->add (Shader::Source_Code::from_string (internal_fragment_shader_a, Shader::Source_Code::FRAGMENT));
+
+        context->add (shader_program_a);
+
+        if (shader_program_a->is_usable ())
+        {
+            shader_program_a->use ();
+
+             transform_a_id = shader_program_a->get_uniform_id ("transform" );
+            projection_a_id = shader_program_a->get_uniform_id ("projection");
+               opacity_a_id = shader_program_a->get_uniform_id ("opacity"   );
+
+              vertex_position_location_a = shader_program_a->get_vertex_attribute_id ("vertex_position"  );
+            vertex_texture_uv_location_a = shader_program_a->get_vertex_attribute_id ("vertex_texture_uv");
+
+            shader_program_a->set_uniform_value (shader_program_a->get_uniform_id ("sampler"      ), 0);
+            shader_program_a->set_uniform_value (shader_program_a->get_uniform_id ("alpha_sampler"), 1);
         }
 
         reset_state ();
@@ -154,11 +202,21 @@ namespace basics { namespace opengles
     void Canvas_ES2::reset_state ()
     {
         glEnable      (GL_BLEND);
-        glBlendFunc   (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glBlendFunc   (GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
         glClearColor  (0.f, 0.f, 0.f, 1.f);
 
         set_size      ({ unsigned(size.width), unsigned(size.height) });
         set_transform (Transformation2f());
+
+        shader_program_t->use ();
+        shader_program_t->set_uniform_value (straight_alpha_t_id, straight_alpha_t ? 1.f : 0.f);
+
+        GLint viewport[4];
+
+        glGetIntegerv (GL_VIEWPORT, viewport);
+
+        pixels_per_unit.width  = float(viewport[2]) / size.width;
+        pixels_per_unit.height = float(viewport[3]) / size.height;
         set_color     (1.f, 1.f, 1.f);
         set_opacity   (1.f);
     }
@@ -175,6 +233,9 @@ namespace basics { namespace opengles
 
         shader_program_t->use ();
         shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
+
+        shader_program_a->use ();
+        shader_program_a->set_uniform_value (projection_a_id, projection.matrix);
     }
 
     void Canvas_ES2::set_clear_color (float r, float g, float b)
@@ -188,6 +249,8 @@ namespace basics { namespace opengles
         shader_program_f->set_uniform_value (opacity_f_id, opacity);
         shader_program_t->use ();
         shader_program_t->set_uniform_value (opacity_t_id, opacity);
+        shader_program_a->use ();
+        shader_program_a->set_uniform_value (opacity_a_id, opacity);
     }
 
     void Canvas_ES2::set_color (float r, float g, float b)
@@ -205,6 +268,9 @@ namespace basics { namespace opengles
 
         shader_program_t->use ();
         shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+
+        shader_program_a->use ();
+        shader_program_a->set_uniform_value (transform_a_id, transform.matrix);
     }
 
     void Canvas_ES2::apply_transform (const Transformation2f & t)
@@ -216,11 +282,18 @@ namespace basics { namespace opengles
 
         shader_program_t->use ();
         shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+
+        shader_program_a->use ();
+        shader_program_a->set_uniform_value (transform_a_id, transform.matrix);
     }
 
     void Canvas_ES2::clear ()
     {
         glClear (GL_COLOR_BUFFER_BIT);
+
+        statistics.textured_quads    = 0;
+        statistics.rasterized_pixels = 0.f;
+        statistics.texture_bytes     = 0.f;
     }
 
     void Canvas_ES2::draw_point (const Point2f & position)
@@ -342,10 +415,35 @@ namespace basics { namespace opengles
                 default:               texture_uvs = normal_texture_uvs; break;
             }
 
+            Size2f quad_size = size;
+
+            if (opengl_es_texture->is_trimmed ())
+            {
+                // La textura solo contiene la parte visible de la imagen, por lo que el quad se
+                // reduce a la zona que esta ocupa dentro del rectángulo original:
+
+                const basics::Texture_2D::Trim & trim = opengl_es_texture->get_trim ();
+
+                if (trim.width <= 0.f || trim.height <= 0.f) return;
+
+                float left_margin   = trim.left / opengl_es_texture->get_width  ();
+                float right_margin  = 1.f - (trim.left + trim.width ) / opengl_es_texture->get_width  ();
+                float top_margin    = trim.top  / opengl_es_texture->get_height ();
+                float bottom_margin = 1.f - (trim.top  + trim.height) / opengl_es_texture->get_height ();
+
+                if (handling & FLIP_HORIZONTAL) std::swap (left_margin, right_margin );
+                if (handling & FLIP_VERTICAL  ) std::swap (top_margin,  bottom_margin);
+
+                bottom_left[0]  += size.width  * left_margin;
+                bottom_left[1]  += size.height * bottom_margin;
+                quad_size.width  = size.width  * (1.f - left_margin - right_margin );
+                quad_size.height = size.height * (1.f - top_margin  - bottom_margin);
+            }
+
             Point2f top_right
             {
-                bottom_left.coordinates.x () + size.width,
-                bottom_left.coordinates.y () + size.height
+                bottom_left.coordinates.x () + quad_size.width,
+                bottom_left.coordinates.y () + quad_size.height
             };
 
             const Point2f coordinates[] =
@@ -356,14 +454,7 @@ namespace basics { namespace opengles
                     top_right,
             };
 
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
-
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+            draw_textured_quad (opengl_es_texture, coordinates, texture_uvs);
         }
     }
 
@@ -434,15 +525,77 @@ namespace basics { namespace opengles
                     top_right,
             };
 
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
+            draw_textured_quad (opengl_es_texture, coordinates, texture_uvs);
+        }
+    }
+
+    void Canvas_ES2::draw_textured_quad (const Texture_2D * texture, const Point2f * coordinates, const Point2f * texture_uvs)
+    {
+        // Las texturas que siguen en la cola de subidas todavía no se pueden dibujar:
+
+        if (!texture->is_usable ()) return;
 
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+        bool     alpha_plane       = texture->has_alpha_plane ();
+        unsigned position_location = alpha_plane ?   vertex_position_location_a :   vertex_position_location_t;
+        unsigned uv_location       = alpha_plane ? vertex_texture_uv_location_a : vertex_texture_uv_location_t;
+
+        texture->use ();
+
+        if (alpha_plane)
+        {
+            shader_program_a->use ();
         }
+        else
+        {
+            shader_program_t->use ();
+
+            if (straight_alpha_t == texture->is_premultiplied ())
+            {
+                straight_alpha_t = !straight_alpha_t;
+
+                shader_program_t->set_uniform_value (straight_alpha_t_id, straight_alpha_t ? 1.f : 0.f);
+            }
+        }
+
+        glEnableVertexAttribArray (position_location);
+        glEnableVertexAttribArray (uv_location);
+        glVertexAttribPointer     (position_location, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glVertexAttribPointer     (uv_location,       2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
+        glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+
+        estimate_texture_traffic  (texture, coordinates, texture_uvs);
+    }
+
+    void Canvas_ES2::estimate_texture_traffic (const Texture_2D * texture, const Point2f * coordinates, const Point2f * texture_uvs)
+    {
+        // Área cubierta en pixels (el determinante da el factor de escala de la transformación):
+
+        float area_scale = std::abs (transform.matrix[0][0] * transform.matrix[1][1] - transform.matrix[0][1] * transform.matrix[1][0]);
+        float pixels     = std::abs ((coordinates[3][0] - coordinates[0][0]) * (coordinates[3][1] - coordinates[0][1]))
+                         * area_scale * pixels_per_unit.width * pixels_per_unit.height;
+
+        // Texels del nivel 0 que caen dentro del quad:
+
+        float texels     = std::abs ((texture_uvs[3][0] - texture_uvs[0][0]) * (texture_uvs[3][1] - texture_uvs[0][1]))
+                         * texture->get_trim ().width * texture->get_trim ().height;
+
+        unsigned levels  = texture->get_mipmap_levels ();
+
+        if (levels > 1 && pixels > 0.f && texels > pixels)
+        {
+            // Cada nivel tiene la cuarta parte de texels que el anterior. Con filtrado trilineal
+            // también se lee el nivel siguiente:
+
+            unsigned level = std::min (levels - 1, unsigned(0.5f * std::log2 (texels / pixels)));
+
+            texels = std::ldexp (texels, -2 * int(level));
+
+            if (texture->is_trilinear () && level + 1 < levels) texels *= 1.25f;
+        }
+
+        statistics.textured_quads++;
+        statistics.rasterized_pixels += pixels;
+        statistics.texture_bytes     += texels * texture->get_bytes_per_texel ();
     }
 
 }}
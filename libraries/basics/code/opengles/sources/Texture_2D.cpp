@@ -10,9 +10,27 @@
  * C1801221334
  */
 
+#include <limits>
+#include <cstring>
+#include <algorithm>
 #include <basics/assert>
+#include <basics/etc_decode>
+#include <basics/Color_Buffer_Filters>
+#include <basics/lz4>
 #include <basics/opengles/Texture_2D>
 
+#ifndef GL_ETC1_RGB8_OES
+    #define GL_ETC1_RGB8_OES                0x8D64
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+    #define GL_COMPRESSED_RGB8_ETC2         0x9274
+#endif
+
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+    #define GL_COMPRESSED_RGBA8_ETC2_EAC    0x9278
+#endif
+
 namespace basics { namespace opengles
 {
 
@@ -20,55 +38,666 @@ namespace basics { namespace opengles
 
     std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
-        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options.width, options.height));
+        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options));
+    }
+
+    std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Compressed_Buffer & compressed_buffer, Compressed_Buffer * compressed_alpha, const Options & options)
+    {
+        return std::shared_ptr< Texture_2D >(new Texture_2D(compressed_buffer, compressed_alpha, options));
+    }
+
+    Texture_2D::Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
+    :
+        basics::Texture_2D(options.width, options.height),
+        options           (options             ),
+        pixel_format      (options.pixel_format),
+        compressed        (false               ),
+        texture_object_id (0                   ),
+        alpha_plane       (false               ),
+        trilinear         (options.trilinear   ),
+        premultiplied     (!options.straight_alpha),
+        compressed_upload (false               ),
+        uploaded_levels   (0                   ),
+        upload_level      (0                   ),
+        upload_row        (0                   )
+    {
+        retention = options.retention;
+
+        prepare (color_buffer);
+
+        // Si se vuelve a procesar la imagen al restaurar la textura debe quedar en el mismo formato:
+
+        this->options.pixel_format = pixel_format;
+    }
+
+    void Texture_2D::prepare (const Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        color_levels.push_back (color_buffer);
+
+        if (options.trim)
+        {
+            trim_transparent_borders ();
+        }
+
+        if (premultiplied)
+        {
+            premultiply_alpha (color_levels.front ());
+        }
+
+        if (pixel_format == PIXEL_FORMAT_AUTOMATIC)
+        {
+            pixel_format = choose_pixel_format (color_levels.front ());
+        }
+
+        if (options.mipmaps)
+        {
+            // Los niveles se reducen con la imagen premultiplicada para que el color de los pixels
+            // transparentes no se mezcle con el de los visibles. Si la textura no se guarda
+            // premultiplicada se deshace la premultiplicación de cada nivel:
+
+            Color_Buffer< Rgba8888 > level = color_levels.front ();
+
+            if (!premultiplied) premultiply_alpha (level);
+
+            while (level.width > 1 || level.height > 1)
+            {
+                Color_Buffer< Rgba8888 > next_level;
+
+                downsample (level, next_level);
+
+                level = next_level;
+
+                if (!premultiplied) unpremultiply_alpha (next_level);
+
+                color_levels.push_back (next_level);
+            }
+        }
+
+        if (pixel_format != PIXEL_FORMAT_RGBA8888)
+        {
+            packed_levels.resize (color_levels.size ());
+
+            for (size_t level = 0; level < color_levels.size (); ++level)
+            {
+                switch (pixel_format)
+                {
+                    case PIXEL_FORMAT_RGB565:   convert_to_rgb565   (color_levels[level], packed_levels[level], options.dither); break;
+                    case PIXEL_FORMAT_RGBA5551: convert_to_rgba5551 (color_levels[level], packed_levels[level], options.dither); break;
+                    default:                    convert_to_rgba4444 (color_levels[level], packed_levels[level], options.dither); break;
+                }
+            }
+
+            color_levels.clear ();
+        }
+    }
+
+    void Texture_2D::trim_transparent_borders ()
+    {
+        Color_Buffer< Rgba8888 > & image = color_levels.front ();
+
+        unsigned left, top, visible_width, visible_height;
+
+        if (find_visible_bounds (image, left, top, visible_width, visible_height))
+        {
+            // Se conserva un texel transparente alrededor de la zona visible (si la imagen lo
+            // tiene) para que el filtrado bilineal de los bordes dé el mismo resultado:
+
+            unsigned right  = std::min (image.width,  left + visible_width  + 1);
+            unsigned bottom = std::min (image.height, top  + visible_height + 1);
+
+            left = left > 0 ? left - 1 : 0;
+            top  = top  > 0 ? top  - 1 : 0;
+
+            visible_width  = right  - left;
+            visible_height = bottom - top;
+        }
+
+        if (visible_width == image.width && visible_height == image.height)
+        {
+            return;
+        }
+
+        // Las coordenadas del recorte se expresan en el tamaño lógico de la textura, que puede
+        // no coincidir con el de la imagen:
+
+        float horizontal_scale = width  / float(image.width );
+        float   vertical_scale = height / float(image.height);
+
+        trim.left   = float(left          ) * horizontal_scale;
+        trim.top    = float(top           ) *   vertical_scale;
+        trim.width  = float(visible_width ) * horizontal_scale;
+        trim.height = float(visible_height) *   vertical_scale;
+
+        // Una imagen completamente transparente se reduce a un texel y un recorte de área nula
+        // que el Canvas no llega a dibujar:
+
+        Color_Buffer< Rgba8888 > cropped;
+
+        crop (image, left, top, std::max (1u, visible_width), std::max (1u, visible_height), cropped);
+
+        image = cropped;
+    }
+
+    namespace
+    {
+
+        bool supports_extension (const char * name)
+        {
+            const char * extensions = reinterpret_cast< const char * >(glGetString (GL_EXTENSIONS));
+
+            return extensions && std::strstr (extensions, name);
+        }
+
+        // ETC2 es obligatorio a partir de OpenGL ES 3.0. Muchos drivers devuelven un contexto 3.x
+        // aunque se pida la versión 2, por lo que se mira la versión real:
+
+        bool is_opengl_es_3 ()
+        {
+            const char * version = reinterpret_cast< const char * >(glGetString (GL_VERSION));
+
+            return version && std::strncmp (version, "OpenGL ES ", 10) == 0 && version[10] >= '3';
+        }
+
+        bool supports_etc1_extension ()
+        {
+            return supports_extension ("GL_OES_compressed_ETC1_RGB8_texture");
+        }
+
+        // OpenGL ES 2 solo admite mipmaps en texturas con dimensiones potencia de 2 salvo que
+        // esté disponible GL_OES_texture_npot:
+
+        bool supports_mipmaps (unsigned width, unsigned height)
+        {
+            bool power_of_two = (width & (width - 1)) == 0 && (height & (height - 1)) == 0;
+
+            return power_of_two || is_opengl_es_3 () || supports_extension ("GL_OES_texture_npot");
+        }
+
+    }
+
+    bool Texture_2D::supports (Compressed_Buffer::Format format)
+    {
+        // ETC1 es un subconjunto de ETC2 RGB8, así que también se acepta con OpenGL ES 3:
+
+        return (format == Compressed_Buffer::ETC1_RGB8 && supports_etc1_extension ()) || is_opengl_es_3 ();
+    }
+
+    float Texture_2D::get_bytes_per_texel () const
+    {
+        if (compressed_upload)
+        {
+            float bytes = compressed_buffer.has_alpha () ? 1.f : .5f;
+
+            return alpha_plane ? bytes + .5f : bytes;
+        }
+
+        return float(get_bytes_per_pixel (pixel_format));
     }
 
     bool Texture_2D::initialize ()
     {
+        size_t uploaded_bytes;
+
+        return initialize_step (std::numeric_limits< size_t >::max (), uploaded_bytes);
+    }
+
+    bool Texture_2D::initialize_step (size_t byte_budget, size_t & uploaded_bytes)
+    {
+        uploaded_bytes = 0;
+
         if (!initialized)
         {
-            if (color_buffer.size () > 0)
+            // Si se descartó la copia de los pixels (y se ha perdido el contexto) primero hay que
+            // recuperarla:
+
+            bool has_pixels = compressed ? compressed_buffer.size () > 0 : !color_levels.empty () || !packed_levels.empty ();
+
+            if (!has_pixels && !restore_pixels ())
             {
-                glEnable        (GL_TEXTURE_2D);////
-                glGenTextures   (1, &texture_object_id);
-                glBindTexture   (GL_TEXTURE_2D, texture_object_id);
-
-                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-                glTexImage2D
-                (
-                    GL_TEXTURE_2D,
-                    0,
-                    GL_RGBA,
-                    color_buffer.get_width  (),
-                    color_buffer.get_height (),
-                    0,
-                    GL_RGBA,
-                    GL_UNSIGNED_BYTE,
-                    color_buffer
-                );
-
-                int error = glGetError ();
-
-                assert(glGetError () == GL_NO_ERROR);
-                assert(width > 0 && height > 0);
-
-                initialized = true;
+                return false;
+            }
+
+            if (compressed)
+            {
+                // La extensión de ETC1 no admite glCompressedTexSubImage2D(), así que los bloques
+                // se suben enteros aunque superen el presupuesto:
+
+                uploaded_bytes = get_pending_upload_size ();
+
+                if (!initialize_compressed ()) uploaded_bytes = 0;
+            }
+            else
+            {
+                upload_levels (byte_budget, uploaded_bytes);
+            }
+
+            if (initialized)
+            {
+                release_pixels ();
             }
         }
 
         return initialized;
     }
 
+    size_t Texture_2D::get_pending_upload_size () const
+    {
+        if (initialized) return 0;
+
+        if (compressed)
+        {
+            return compressed_buffer.size () + compressed_alpha.size ();
+        }
+
+        size_t   pending         = 0;
+        unsigned bytes_per_pixel = get_bytes_per_pixel (pixel_format);
+
+        if (color_levels.empty () && packed_levels.empty ())
+        {
+            for (auto & level : retained_levels)
+            {
+                pending += size_t(level.width) * level.height * bytes_per_pixel;
+            }
+
+            return pending;
+        }
+
+        // Antes de empezar no se sabe si la GPU admitirá los mipmaps, así que se cuentan todos:
+
+        size_t levels = std::max (color_levels.size (), packed_levels.size ());
+
+        for (unsigned index = upload_level; index < levels; ++index)
+        {
+            Level    level      = get_level (index);
+            unsigned first_row  = index == upload_level ? upload_row : 0;
+
+            pending += size_t(level.width) * (level.height - first_row) * bytes_per_pixel;
+        }
+
+        return pending;
+    }
+
+    size_t Texture_2D::get_gpu_memory_size () const
+    {
+        if (!initialized) return 0;
+
+        // El primer nivel tiene el tamaño de la imagen después de recortar los bordes:
+
+        unsigned width  = unsigned(trim.width );
+        unsigned height = unsigned(trim.height);
+        double   texels = 0.0;
+
+        for (unsigned level = 0; level < uploaded_levels; ++level)
+        {
+            texels += double(std::max (1u, width >> level)) * std::max (1u, height >> level);
+        }
+
+        return size_t(texels * get_bytes_per_texel ());
+    }
+
+    size_t Texture_2D::get_cpu_memory_size () const
+    {
+        size_t size = compressed_buffer.size () + compressed_alpha.size ();
+
+        for (auto & level : color_levels   ) size += level.size () * 4;
+        for (auto & level : packed_levels  ) size += level.size () * 2;
+        for (auto & level : retained_levels) size += level.data.size ();
+
+        return size;
+    }
+
+    void Texture_2D::release_pixels ()
+    {
+        Retention policy = retention;
+
+        // Sin un asset de origen la imagen no se puede volver a leer:
+
+        if ((policy == RETAIN_MAPPED_ASSET || policy == RETAIN_ASSET_PATH) && source.asset_path.empty ())
+        {
+            policy = RETAIN_COMPRESSED;
+        }
+
+        if (policy == RETAIN_PIXELS)
+        {
+            return;
+        }
+
+        if (compressed)
+        {
+            // Los bloques ETC ya ocupan poco, así que con RETAIN_COMPRESSED se conservan tal cual:
+
+            if (policy != RETAIN_COMPRESSED)
+            {
+                Compressed_Buffer::Buffer ().swap (compressed_buffer.blocks);
+                Compressed_Buffer::Buffer ().swap (compressed_alpha .blocks);
+            }
+
+            return;
+        }
+
+        // Solo se conservan los niveles que se han llegado a subir. Si se restauró desde esta
+        // misma copia no hace falta volver a comprimir:
+
+        if (policy == RETAIN_COMPRESSED && retained_levels.empty ())
+        {
+            unsigned            bytes_per_pixel = get_bytes_per_pixel (pixel_format);
+            std::vector< byte > buffer;
+
+            retained_levels.resize (uploaded_levels);
+
+            for (unsigned index = 0; index < uploaded_levels; ++index)
+            {
+                Level            level    = get_level (index);
+                Retained_Level & retained = retained_levels[index];
+
+                retained.width  = level.width;
+                retained.height = level.height;
+
+                // lz4_compress() reserva espacio para el peor caso, así que el resultado se copia
+                // a un vector de su tamaño justo:
+
+                lz4_compress (level.pixels, size_t(level.width) * level.height * bytes_per_pixel, buffer);
+
+                retained.data.assign (buffer.begin (), buffer.end ());
+            }
+        }
+
+        Color_Levels  ().swap (color_levels );
+        Packed_Levels ().swap (packed_levels);
+    }
+
+    bool Texture_2D::restore_pixels ()
+    {
+        if (!retained_levels.empty ())
+        {
+            for (auto & retained : retained_levels)
+            {
+                bool success;
+
+                if (pixel_format == PIXEL_FORMAT_RGBA8888)
+                {
+                    color_levels.emplace_back ();
+                    color_levels.back ().resize (retained.width, retained.height);
+
+                    success = lz4_decompress
+                    (
+                        retained.data.data (),
+                        retained.data.size (),
+                        reinterpret_cast< byte * >(color_levels.back ().buffer.data ()),
+                        size_t(retained.width) * retained.height * 4
+                    );
+                }
+                else
+                {
+                    packed_levels.emplace_back ();
+                    packed_levels.back ().resize (retained.width, retained.height);
+
+                    success = lz4_decompress
+                    (
+                        retained.data.data (),
+                        retained.data.size (),
+                        reinterpret_cast< byte * >(packed_levels.back ().buffer.data ()),
+                        size_t(retained.width) * retained.height * 2
+                    );
+                }
+
+                if (!success)
+                {
+                    color_levels .clear ();
+                    packed_levels.clear ();
+
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        Color_Buffer< Rgba8888 > color_buffer;
+
+        if (!reload (color_buffer, compressed_buffer, compressed_alpha))
+        {
+            return false;
+        }
+
+        if (!compressed)
+        {
+            prepare (color_buffer);
+        }
+
+        return true;
+    }
+
+    bool Texture_2D::initialize_compressed ()
+    {
+        bool separate_alpha = compressed_alpha.size () > 0;
+
+        if (supports (compressed_buffer.format) && (!separate_alpha || supports (compressed_alpha.format)))
+        {
+            texture_object_id = create_texture_object (1);
+
+            upload (compressed_buffer);
+
+            if (separate_alpha)
+            {
+                alpha_texture_object_id = create_texture_object (1);
+
+                upload (compressed_alpha);
+
+                alpha_plane = true;
+            }
+
+            compressed_upload = true;
+        }
+        else
+        {
+            // Si la GPU no soporta el formato se descomprime en la CPU y se sube como RGBA:
+
+            Color_Buffer< Rgba8888 > decoded;
+
+            bool success = separate_alpha
+                         ? etc_decode (compressed_buffer, compressed_alpha, decoded)
+                         : etc_decode (compressed_buffer, decoded);
+
+            if (!success) return false;
+
+            texture_object_id = create_texture_object (1);
+
+            upload (0, { decoded.width, decoded.height, reinterpret_cast< const byte * >(decoded.buffer.data ()) }, 0, decoded.height);
+        }
+
+        uploaded_levels = 1;
+
+        assert(width > 0 && height > 0);
+
+        return initialized = true;
+    }
+
+    void Texture_2D::upload_levels (size_t byte_budget, size_t & uploaded_bytes)
+    {
+        size_t levels = std::max (color_levels.size (), packed_levels.size ());
+
+        if (levels == 0) return;
+
+        if (texture_object_id == 0)
+        {
+            // Si se han recortado los bordes el nivel 0 puede ser menor que el tamaño lógico:
+
+            Level first_level = get_level (0);
+
+            uploaded_levels   = levels > 1 && supports_mipmaps (first_level.width, first_level.height) ? unsigned(levels) : 1;
+            texture_object_id = create_texture_object (uploaded_levels);
+            upload_level      = 0;
+            upload_row        = 0;
+        }
+        else
+        {
+            // Otras texturas se han podido enlazar desde el paso anterior:
+
+            glBindTexture (GL_TEXTURE_2D, texture_object_id);
+
+            active_texture = nullptr;
+        }
+
+        unsigned bytes_per_pixel = get_bytes_per_pixel (pixel_format);
+
+        while (upload_level < uploaded_levels)
+        {
+            Level    level     = get_level (upload_level);
+            size_t   row_size  = size_t(level.width) * bytes_per_pixel;
+            size_t   remaining = byte_budget > uploaded_bytes ? byte_budget - uploaded_bytes : 0;
+            unsigned row_count = level.height - upload_row;
+
+            if (row_count * row_size > remaining)
+            {
+                row_count = unsigned(remaining / row_size);
+
+                // Cada paso sube al menos una fila para que la textura termine de subirse:
+
+                if (row_count == 0)
+                {
+                    if (uploaded_bytes > 0) break;
+
+                    row_count = 1;
+                }
+            }
+
+            upload (GLint(upload_level), level, upload_row, row_count);
+
+            uploaded_bytes += row_count * row_size;
+            upload_row     += row_count;
+
+            if (upload_row == level.height)
+            {
+                upload_level++;
+                upload_row = 0;
+            }
+        }
+
+        if (upload_level == uploaded_levels)
+        {
+            assert(width > 0 && height > 0);
+
+            initialized = true;
+        }
+    }
+
+    Texture_2D::Level Texture_2D::get_level (unsigned index) const
+    {
+        if (packed_levels.empty ())
+        {
+            const Color_Buffer< Rgba8888 > & level = color_levels[index];
+
+            return { level.width, level.height, reinterpret_cast< const byte * >(level.buffer.data ()) };
+        }
+
+        const Color_Buffer< uint16_t > & level = packed_levels[index];
+
+        return { level.width, level.height, reinterpret_cast< const byte * >(level.buffer.data ()) };
+    }
+
+    GLuint Texture_2D::create_texture_object (unsigned levels)
+    {
+        GLuint texture_object_id;
+        GLint  min_filter = GL_LINEAR;
+
+        if (levels > 1)
+        {
+            min_filter = trilinear ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST;
+        }
+
+        glGenTextures   (1, &texture_object_id);
+        glBindTexture   (GL_TEXTURE_2D, texture_object_id);
+
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        return texture_object_id;
+    }
+
+    void Texture_2D::upload (GLint level, const Level & data, unsigned first_row, unsigned row_count)
+    {
+        GLenum format = GL_RGBA;
+        GLenum type   = GL_UNSIGNED_BYTE;
+
+        switch (pixel_format)
+        {
+            case PIXEL_FORMAT_RGB565:   format = GL_RGB; type = GL_UNSIGNED_SHORT_5_6_5;   break;
+            case PIXEL_FORMAT_RGBA5551:                  type = GL_UNSIGNED_SHORT_5_5_5_1; break;
+            case PIXEL_FORMAT_RGBA4444:                  type = GL_UNSIGNED_SHORT_4_4_4_4; break;
+            default:                                                                       break;
+        }
+
+        // Las filas de 16 bits de las imágenes con ancho impar no están alineadas a 4 bytes:
+
+        if (type != GL_UNSIGNED_BYTE) glPixelStorei (GL_UNPACK_ALIGNMENT, 2);
+
+        if (first_row == 0 && row_count == data.height)
+        {
+            glTexImage2D (GL_TEXTURE_2D, level, GLint(format), data.width, data.height, 0, format, type, data.pixels);
+        }
+        else
+        {
+            // Al subir por partes, la primera franja reserva el nivel completo:
+
+            if (first_row == 0)
+            {
+                glTexImage2D (GL_TEXTURE_2D, level, GLint(format), data.width, data.height, 0, format, type, nullptr);
+            }
+
+            const byte * rows = data.pixels + size_t(first_row) * data.width * get_bytes_per_pixel (pixel_format);
+
+            glTexSubImage2D (GL_TEXTURE_2D, level, 0, GLint(first_row), data.width, row_count, format, type, rows);
+        }
+
+        if (type != GL_UNSIGNED_BYTE) glPixelStorei (GL_UNPACK_ALIGNMENT, 4);
+
+        assert(glGetError () == GL_NO_ERROR);
+    }
+
+    void Texture_2D::upload (const Compressed_Buffer & compressed_buffer)
+    {
+        GLenum internal_format;
+
+        switch (compressed_buffer.format)
+        {
+            case Compressed_Buffer::ETC1_RGB8:  internal_format = supports_etc1_extension ()
+                                                                ? GL_ETC1_RGB8_OES
+                                                                : GL_COMPRESSED_RGB8_ETC2;       break;
+            case Compressed_Buffer::ETC2_RGB8:  internal_format = GL_COMPRESSED_RGB8_ETC2;       break;
+            default:                            internal_format = GL_COMPRESSED_RGBA8_ETC2_EAC;  break;
+        }
+
+        glCompressedTexImage2D
+        (
+            GL_TEXTURE_2D,
+            0,
+            internal_format,
+            compressed_buffer.width,
+            compressed_buffer.height,
+            0,
+            GLsizei(compressed_buffer.size ()),
+            compressed_buffer.blocks.data ()
+        );
+
+        assert(glGetError () == GL_NO_ERROR);
+    }
+
     bool Texture_2D::use () const
     {
         assert(is_usable ());
 
         //if (active_texture != this)
         {
+            if (alpha_plane)
+            {
+                glActiveTexture (GL_TEXTURE1);
+                glBindTexture   (GL_TEXTURE_2D, alpha_texture_object_id);
+                glActiveTexture (GL_TEXTURE0);
+            }
+
             glBindTexture   (GL_TEXTURE_2D, texture_object_id);
             glActiveTexture (GL_TEXTURE0);
 
@@ -18,7 +18,12 @@
     namespace basics
     {
 
-        bool png_decode (const std::vector< byte > & encoded_data, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height);
+        bool png_decode (const byte * encoded_data, size_t encoded_size, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height);
+
+        inline bool png_decode (const std::vector< byte > & encoded_data, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height)
+        {
+            return png_decode (encoded_data.data (), encoded_data.size (), color_buffer, width, height);
+        }
 
     }
 
@@ -18,7 +18,8 @@ namespace basics
 
     bool png_decode
     (
-        const std::vector< byte > & encoded_data,
+        const byte                * encoded_data,
+        size_t                      encoded_size,
         Color_Buffer < Rgba8888 > & color_buffer,
         unsigned & width,
         unsigned & height
@@ -32,6 +33,7 @@ namespace basics
             width,
             height,
             encoded_data,
+            encoded_size,
             LCT_RGBA,
             8
         );
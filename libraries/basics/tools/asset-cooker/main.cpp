@@ -0,0 +1,126 @@
+/*
+ * ASSET COOKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181710
+ */
+
+// Convierte atlas de darkFunction Editor (.sprites) y fuentes XML de BMFont (.fnt) al formato
+// binario de basics/cooked:
+//
+//     asset-cooker input.sprites|input.fnt...
+//
+// Cada archivo se guarda junto al original añadiendo ".bin" a su nombre, que es donde lo buscan
+// Atlas y Raster_Font.
+
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <basics/cooked>
+
+using namespace basics;
+
+namespace
+{
+
+    bool read_file (const std::string & path, std::vector< byte > & data)
+    {
+        std::ifstream reader(path, std::ios::binary);
+
+        if (!reader) return false;
+
+        data.assign (std::istreambuf_iterator< char >(reader), std::istreambuf_iterator< char >());
+
+        return true;
+    }
+
+    bool write_file (const std::string & path, const std::vector< byte > & data)
+    {
+        std::ofstream writer(path, std::ios::binary);
+
+        writer.write (reinterpret_cast< const char * >(data.data ()), std::streamsize(data.size ()));
+
+        return writer.good ();
+    }
+
+    bool ends_with (const std::string & string, const std::string & suffix)
+    {
+        return string.size () >= suffix.size () && string.compare (string.size () - suffix.size (), suffix.size (), suffix) == 0;
+    }
+
+    bool cook (const std::string & input_path)
+    {
+        std::vector< byte > xml;
+        std::vector< byte > cooked_data;
+        std::string         output_path = input_path + cooked::suffix;
+        size_t              original_size;
+
+        if (!read_file (input_path, xml))
+        {
+            std::fprintf (stderr, "error: can't read %s\n", input_path.c_str ());
+            return false;
+        }
+
+        original_size = xml.size ();
+
+        if (ends_with (input_path, ".fnt"))
+        {
+            cooked::Font_Data font_data;
+
+            if (!cooked::parse_font_xml (xml, font_data))
+            {
+                std::fprintf (stderr, "error: %s is not a valid single page BMFont XML file\n", input_path.c_str ());
+                return false;
+            }
+
+            cooked::write_font (font_data, cooked_data);
+        }
+        else
+        {
+            cooked::Atlas_Data atlas_data;
+
+            if (!cooked::parse_atlas_xml (xml, atlas_data))
+            {
+                std::fprintf (stderr, "error: %s is not a valid sprites file\n", input_path.c_str ());
+                return false;
+            }
+
+            cooked::write_atlas (atlas_data, cooked_data);
+        }
+
+        if (!write_file (output_path, cooked_data))
+        {
+            std::fprintf (stderr, "error: can't write %s\n", output_path.c_str ());
+            return false;
+        }
+
+        std::printf ("%s: %zu -> %zu bytes\n", output_path.c_str (), original_size, cooked_data.size ());
+
+        return true;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    if (number_of_arguments < 2)
+    {
+        std::fprintf (stderr, "usage: asset-cooker input.sprites|input.fnt...\n");
+        return 1;
+    }
+
+    bool success = true;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        success = cook (arguments[index]) && success;
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/*
+ * ETC CONVERTER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181300
+ */
+
+// Convierte imágenes PNG a archivos PKM que Texture_2D::create() puede cargar directamente:
+//
+//     etc-converter [--etc1] input.png output.pkm
+//
+// Por defecto se genera ETC2 (RGB8 si la imagen es opaca o RGBA8 con alfa EAC si no lo es).
+// Con --etc1 se genera ETC1 y, si la imagen tiene alfa, se guarda aparte en output.alpha.pkm.
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <basics/etc_decode>
+#include <basics/etc_encode>
+#include <basics/png_decode>
+
+using namespace basics;
+
+namespace
+{
+
+    bool read_file (const std::string & path, std::vector< byte > & data)
+    {
+        std::ifstream reader(path, std::ios::binary);
+
+        if (!reader) return false;
+
+        data.assign (std::istreambuf_iterator< char >(reader), std::istreambuf_iterator< char >());
+
+        return true;
+    }
+
+    bool write_file (const std::string & path, const std::vector< byte > & data)
+    {
+        std::ofstream writer(path, std::ios::binary);
+
+        writer.write (reinterpret_cast< const char * >(data.data ()), std::streamsize(data.size ()));
+
+        return writer.good ();
+    }
+
+    bool has_alpha (Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        const byte * pixels = color_buffer;
+
+        for (unsigned index = 0, size = color_buffer.size (); index < size; ++index)
+        {
+            if (pixels[index * 4 + 3] != 255) return true;
+        }
+
+        return false;
+    }
+
+    double get_psnr (Color_Buffer< Rgba8888 > & original, Color_Buffer< Rgba8888 > & decoded)
+    {
+        const byte * a = original;
+        const byte * b = decoded;
+        double   error = 0.0;
+        unsigned count = original.size () * 4;
+
+        for (unsigned index = 0; index < count; ++index)
+        {
+            double difference = double(a[index]) - double(b[index]);
+
+            error += difference * difference;
+        }
+
+        return error == 0.0 ? 99.0 : 10.0 * std::log10 (255.0 * 255.0 * count / error);
+    }
+
+    bool save (const Compressed_Buffer & compressed_buffer, const std::string & path)
+    {
+        std::vector< byte > encoded_data;
+
+        return pkm_encode (compressed_buffer, encoded_data) && write_file (path, encoded_data);
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    bool etc1 = number_of_arguments == 4 && std::string(arguments[1]) == "--etc1";
+
+    if (number_of_arguments != 3 + int(etc1))
+    {
+        std::fprintf (stderr, "usage: etc-converter [--etc1] input.png output.pkm\n");
+        return 1;
+    }
+
+    std::string input_path  = arguments[1 + int(etc1)];
+    std::string output_path = arguments[2 + int(etc1)];
+
+    std::vector< byte >      png_data;
+    Color_Buffer< Rgba8888 > image;
+    unsigned                 width, height;
+
+    if (!read_file (input_path, png_data) || !png_decode (png_data, image, width, height))
+    {
+        std::fprintf (stderr, "error: can't read %s\n", input_path.c_str ());
+        return 1;
+    }
+
+    bool                      alpha  = has_alpha (image);
+    Compressed_Buffer::Format format = etc1  ? Compressed_Buffer::ETC1_RGB8  :
+                                       alpha ? Compressed_Buffer::ETC2_RGBA8 : Compressed_Buffer::ETC2_RGB8;
+
+    Compressed_Buffer        compressed_color;
+    Compressed_Buffer        compressed_alpha;
+    Color_Buffer< Rgba8888 > decoded;
+
+    etc_encode (image, format, compressed_color);
+
+    bool separate_alpha = etc1 && alpha;
+
+    if (separate_alpha)
+    {
+        etc_encode_alpha (image, compressed_alpha);
+        etc_decode       (compressed_color, compressed_alpha, decoded);
+    }
+    else
+    {
+        etc_decode (compressed_color, decoded);
+    }
+
+    if (!save (compressed_color, output_path))
+    {
+        std::fprintf (stderr, "error: can't write %s\n", output_path.c_str ());
+        return 1;
+    }
+
+    size_t compressed_size = compressed_color.size ();
+
+    if (separate_alpha)
+    {
+        // foo.pkm -> foo.alpha.pkm (la convención que sigue Texture_2D::create()):
+
+        std::string alpha_path = output_path.substr (0, output_path.rfind ('.')) + ".alpha.pkm";
+
+        if (!save (compressed_alpha, alpha_path))
+        {
+            std::fprintf (stderr, "error: can't write %s\n", alpha_path.c_str ());
+            return 1;
+        }
+
+        compressed_size += compressed_alpha.size ();
+    }
+
+    std::printf
+    (
+        "%s: %ux%u %s%s, %zu -> %zu bytes, PSNR %.2f dB\n",
+        input_path.c_str (),
+        width,
+        height,
+        format == Compressed_Buffer::ETC1_RGB8 ? "ETC1" : format == Compressed_Buffer::ETC2_RGB8 ? "ETC2 RGB8" : "ETC2 RGBA8",
+        separate_alpha ? " + alpha" : "",
+        size_t(width) * height * 4,
+        compressed_size,
+        get_psnr (image, decoded)
+    );
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * EVENT QUEUE BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181830
+ */
+
+// Varios hilos envían eventos de toque a la vez mientras un consumidor los procesa por lotes,
+// como hacen el hilo de entrada y el bucle del Director:
+//
+//     event-queue-benchmark [events-per-producer]
+//
+// Para cada número de productores se muestra el rendimiento total y el tiempo medio y máximo que
+// tarda cada push(), con Event_Queue y con la cola anterior (std::queue protegida con un mutex).
+
+#include <queue>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <basics/Event_Queue>
+
+using namespace basics;
+
+namespace
+{
+
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * La implementación anterior de Event_Queue, como referencia.
+     */
+    class Mutex_Event_Queue
+    {
+
+        std::queue< Event > queue;
+        std::mutex          mutex;
+
+    public:
+
+        bool push (Event && event)
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            queue.push (event);
+
+            return true;
+        }
+
+        template< class HANDLER >
+        size_t drain (HANDLER && handler)
+        {
+            size_t count = 0;
+            Event  event;
+
+            for (;;)
+            {
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    if (queue.empty ()) break;
+
+                    event = queue.front ();
+
+                    queue.pop ();
+                }
+
+                handler (event);
+                count++;
+            }
+
+            return count;
+        }
+
+    };
+
+    struct Result
+    {
+        double events_per_second;
+        double average_push_ns;
+        double maximum_push_ns;
+        size_t dropped;
+    };
+
+    template< class QUEUE >
+    Result run (QUEUE & queue, unsigned producers, size_t events_per_producer)
+    {
+        std::atomic< unsigned > ready   (0);
+        std::atomic< bool     > start   (false);
+        std::atomic< unsigned > finished(0);
+        std::atomic< size_t   > dropped (0);
+        std::vector< double   > push_total  (producers);
+        std::vector< double   > push_maximum(producers);
+        std::vector< std::thread > threads;
+
+        for (unsigned producer = 0; producer < producers; ++producer)
+        {
+            threads.emplace_back ([&, producer] ()
+            {
+                double total   = 0.0;
+                double maximum = 0.0;
+
+                ready++;
+
+                while (!start) std::this_thread::yield ();
+
+                for (size_t index = 0; index < events_per_producer; ++index)
+                {
+                    Event event(ID(touch-moved));
+
+                    event[ID(x)] = float(index);
+                    event[ID(y)] = float(producer);
+
+                    Clock::time_point before = Clock::now ();
+
+                    if (!queue.push (std::move (event))) dropped++;
+
+                    double elapsed = std::chrono::duration< double, std::nano >(Clock::now () - before).count ();
+
+                    total  += elapsed;
+                    maximum = std::max (maximum, elapsed);
+                }
+
+                push_total  [producer] = total;
+                push_maximum[producer] = maximum;
+
+                finished++;
+            });
+        }
+
+        while (ready < producers) std::this_thread::yield ();
+
+        Clock::time_point begin    = Clock::now ();
+        size_t            consumed = 0;
+        float             checksum = 0.f;
+
+        start = true;
+
+        // El consumidor procesa lo que haya en cada pasada, como el Director en cada fotograma:
+
+        for (;;)
+        {
+            bool done = finished == producers;
+
+            size_t count = queue.drain ([&] (Event & event) { checksum += *event[ID(x)].template as< var::Float > (); });
+
+            consumed += count;
+
+            if (done && consumed + dropped >= producers * events_per_producer) break;
+
+            // Si no había nada se cede el procesador a los productores:
+
+            if (count == 0) std::this_thread::yield ();
+        }
+
+        double seconds = std::chrono::duration< double >(Clock::now () - begin).count ();
+
+        for (auto & thread : threads) thread.join ();
+
+        Result result;
+
+        result.events_per_second = consumed / seconds;
+        result.average_push_ns   = 0.0;
+        result.maximum_push_ns   = 0.0;
+        result.dropped           = dropped;
+
+        for (unsigned producer = 0; producer < producers; ++producer)
+        {
+            result.average_push_ns += push_total[producer] / (double(events_per_producer) * producers);
+            result.maximum_push_ns  = std::max (result.maximum_push_ns, push_maximum[producer]);
+        }
+
+        if (checksum < 0.f) std::printf ("?");
+
+        return result;
+    }
+
+    void print (const char * name, unsigned producers, const Result & result)
+    {
+        std::printf
+        (
+            "%-10s %2u producers: %10.0f events/s, push %7.1f ns avg %9.0f ns max, %zu dropped\n",
+            name,
+            producers,
+            result.events_per_second,
+            result.average_push_ns,
+            result.maximum_push_ns,
+            result.dropped
+        );
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    size_t events_per_producer = number_of_arguments > 1 ? std::strtoul (arguments[1], nullptr, 10) : 200000;
+
+    for (unsigned producers : { 1u, 2u, 4u, 8u })
+    {
+        {
+            Mutex_Event_Queue queue;
+
+            print ("mutex", producers, run (queue, producers, events_per_producer));
+        }
+
+        {
+            Event_Queue queue(1024, Event_Queue::WAIT);
+
+            print ("lock-free", producers, run (queue, producers, events_per_producer));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+/*
+ * JOB SYSTEM BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181910
+ */
+
+// Micro benchmarks de Job_System:
+//
+//   - spawn:        crear y lanzar trabajos vacíos hijos de uno y esperarlo (por trabajo).
+//   - steal:        desde que un hilo lanza un trabajo hasta que otro lo empieza (el que lo lanza
+//                   no ayuda, así que alguien se lo tiene que robar).
+//   - wait:         desde que termina el último trabajo hasta que wait() retorna.
+//   - parallel_for: un bucle de cálculo en serie y con parallel_for().
+//   - large range:  parallel_for() con un trozo por elemento sobre un rango que necesita muchos
+//                   más trabajos de los que caben en el anillo de un lane (comprueba el resultado).
+//
+//     job-system-benchmark [lanes] [iterations]
+//
+// Sin lanes se usa uno por núcleo. Las latencias que dependen de otros hilos solo tienen sentido
+// con al menos dos núcleos libres.
+
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <basics/Job_System>
+
+using namespace basics;
+
+namespace
+{
+
+    typedef std::chrono::steady_clock Clock;
+
+    inline int64_t now ()
+    {
+        return std::chrono::duration_cast< std::chrono::nanoseconds > (Clock::now ().time_since_epoch ()).count ();
+    }
+
+    void print_percentiles (const char * label, std::vector< int64_t > & samples)
+    {
+        std::sort (samples.begin (), samples.end ());
+
+        std::printf
+        (
+            "%-14s median %8.2f us  p90 %8.2f us  p99 %8.2f us\n",
+            label,
+            samples[samples.size () / 2        ] / 1000.0,
+            samples[samples.size () * 90 / 100 ] / 1000.0,
+            samples[samples.size () * 99 / 100 ] / 1000.0
+        );
+    }
+
+    void benchmark_spawn (Job_System & job_system, size_t iterations)
+    {
+        const size_t jobs = 512;
+
+        int64_t start = now ();
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Job_System::Job * root = job_system.create ([] () { });
+
+            for (size_t index = 0; index < jobs; ++index)
+            {
+                job_system.run (job_system.create_child (root, [] () { }));
+            }
+
+            job_system.run  (root);
+            job_system.wait (root);
+        }
+
+        std::printf ("%-14s %8.1f ns per job (%zu jobs per wait)\n", "spawn", double(now () - start) / (iterations * jobs), jobs);
+    }
+
+    void benchmark_steal (Job_System & job_system, size_t iterations)
+    {
+        std::vector< int64_t > latencies;
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::atomic< int64_t > started(0);
+
+            int64_t pushed = now ();
+
+            Job_System::Job * job = job_system.create ([&started] () { started.store (now ()); });
+
+            job_system.run (job);
+
+            // No se llama a wait() para que el trabajo lo tenga que robar otro hilo:
+
+            while (!job_system.is_finished (job)) std::this_thread::yield ();
+
+            latencies.push_back (started.load () - pushed);
+        }
+
+        print_percentiles ("steal", latencies);
+    }
+
+    void benchmark_wait (Job_System & job_system, size_t iterations)
+    {
+        std::vector< int64_t > latencies;
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::atomic< int64_t > finished(0);
+
+            Job_System::Job * root = job_system.create ([] () { });
+
+            for (size_t index = 0; index < 8; ++index)
+            {
+                job_system.run (job_system.create_child (root, [&finished] ()
+                {
+                    volatile double x = 1.0;
+
+                    for (int step = 0; step < 2000; ++step) x = x * 1.0000001;
+
+                    finished.store (now ());
+                }));
+            }
+
+            job_system.run  (root);
+            job_system.wait (root);
+
+            latencies.push_back (now () - finished.load ());
+        }
+
+        print_percentiles ("wait", latencies);
+    }
+
+    void benchmark_parallel_for (Job_System & job_system, size_t iterations)
+    {
+        std::vector< float > values(1 << 20);
+
+        auto kernel = [&values] (size_t first, size_t last)
+        {
+            for (size_t index = first; index < last; ++index)
+            {
+                values[index] = std::sqrt (float(index)) * std::sin (float(index));
+            }
+        };
+
+        int64_t start = now ();
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration) kernel (0, values.size ());
+
+        int64_t serial = now () - start;
+
+        start = now ();
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            job_system.parallel_for (0, values.size (), 16384, kernel);
+        }
+
+        int64_t parallel = now () - start;
+
+        std::printf
+        (
+            "%-14s serial %7.2f ms  parallel %7.2f ms  speedup %.2fx\n",
+            "parallel_for",
+            serial   / 1e6 / iterations,
+            parallel / 1e6 / iterations,
+            double(serial) / double(parallel)
+        );
+    }
+
+
+    bool benchmark_large_range (Job_System & job_system, size_t iterations)
+    {
+        const size_t count = 16 * Job_System::jobs_per_lane * job_system.get_lane_count ();
+
+        std::vector< uint8_t > visits(count);
+
+        int64_t start = now ();
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            job_system.parallel_for (0, count, 1, [&visits] (size_t first, size_t last)
+            {
+                for (size_t index = first; index < last; ++index) visits[index]++;
+            });
+        }
+
+        int64_t elapsed = now () - start;
+
+        // Cada elemento se tiene que haber visitado exactamente una vez por iteración:
+
+        bool correct = std::all_of (visits.begin (), visits.end (), [iterations] (uint8_t value)
+        {
+            return value == uint8_t(iterations);
+        });
+
+        std::printf
+        (
+            "%-14s %8.1f ns per element (%zu elements, grain 1) %s\n",
+            "large range",
+            double(elapsed) / (iterations * count),
+            count,
+            correct ? "ok" : "WRONG RESULT"
+        );
+
+        return correct;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned lanes      = number_of_arguments > 1 ? unsigned(std::atoi (arguments[1])) : 0;
+    size_t   iterations = number_of_arguments > 2 ? size_t  (std::atoi (arguments[2])) : 2000;
+
+    Job_System job_system(lanes);
+
+    std::printf ("%u lanes (%u hardware threads)\n", job_system.get_lane_count (), std::thread::hardware_concurrency ());
+
+    benchmark_spawn        (job_system, iterations);
+
+    if (job_system.get_lane_count () > 1)
+    {
+        benchmark_steal    (job_system, iterations);
+    }
+
+    benchmark_wait         (job_system, iterations);
+    benchmark_parallel_for (job_system, std::max< size_t > (1, iterations / 200));
+
+    return benchmark_large_range (job_system, std::max< size_t > (1, std::min< size_t > (200, iterations / 200))) ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+/*
+ * PACK BUILDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181630
+ */
+
+// Empaqueta todos los archivos de una carpeta (recursivamente) en un Asset_Pack:
+//
+//     pack-builder assets_folder output.pak
+//
+// Las rutas de las entradas son relativas a la carpeta y usan '/' como separador, que es como se
+// pasan a Asset::open(). Cada archivo se comprime con LZ4 solo si así ocupa al menos un 1/8 menos.
+
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <basics/Asset_Pack>
+#include <basics/lz4>
+
+using namespace basics;
+
+namespace
+{
+
+    bool read_file (const std::string & path, std::vector< byte > & data)
+    {
+        std::ifstream reader(path, std::ios::binary);
+
+        if (!reader) return false;
+
+        data.assign (std::istreambuf_iterator< char >(reader), std::istreambuf_iterator< char >());
+
+        return true;
+    }
+
+    void list_files (const std::string & folder, const std::string & prefix, std::vector< std::string > & paths)
+    {
+        DIR * directory = opendir (folder.c_str ());
+
+        if (!directory) return;
+
+        while (dirent * item = readdir (directory))
+        {
+            std::string name = item->d_name;
+
+            if (name == "." || name == "..") continue;
+
+            struct stat status;
+
+            if (stat ((folder + '/' + name).c_str (), &status) != 0) continue;
+
+            if (S_ISDIR(status.st_mode))
+            {
+                list_files (folder + '/' + name, prefix + name + '/', paths);
+            }
+            else
+            if (S_ISREG(status.st_mode))
+            {
+                paths.push_back (prefix + name);
+            }
+        }
+
+        closedir (directory);
+    }
+
+    void pad (std::vector< byte > & output, size_t alignment)
+    {
+        output.resize ((output.size () + alignment - 1) / alignment * alignment, 0);
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    if (number_of_arguments != 3)
+    {
+        std::fprintf (stderr, "usage: pack-builder assets_folder output.pak\n");
+        return 1;
+    }
+
+    std::string folder      = arguments[1];
+    std::string output_path = arguments[2];
+
+    std::vector< std::string > paths;
+
+    list_files (folder, "", paths);
+
+    // Se ordenan para que el resultado no dependa del orden en que el sistema lista los archivos
+    // y se descarta el propio paquete si se genera dentro de la carpeta:
+
+    std::sort (paths.begin (), paths.end ());
+
+    std::map< Id, std::string > ids;
+    std::vector< std::string >  selected;
+
+    for (auto & path : paths)
+    {
+        if (folder + '/' + path == output_path) continue;
+
+        Id id = Asset_Pack::get_id (path);
+
+        if (ids.count (id))
+        {
+            std::fprintf (stderr, "error: %s and %s have the same id\n", ids[id].c_str (), path.c_str ());
+            return 1;
+        }
+
+        ids[id] = path;
+
+        selected.push_back (path);
+    }
+
+    uint32_t slot_count = 1;
+
+    while (slot_count < selected.size () * 2) slot_count *= 2;
+
+    // Se reserva el espacio de la cabecera y de la tabla y se añaden las rutas:
+
+    std::vector< Asset_Pack::Entry > slots(slot_count, Asset_Pack::Entry{ 0, 0, 0, 0, 0, 0 });
+    std::vector< Asset_Pack::Entry > entries(selected.size ());
+    std::vector< byte >              output (sizeof(Asset_Pack::Header) + slot_count * sizeof(Asset_Pack::Entry), 0);
+
+    for (size_t index = 0; index < selected.size (); ++index)
+    {
+        entries[index].id          = Asset_Pack::get_id (selected[index]);
+        entries[index].path_offset = uint32_t(output.size ());
+
+        output.insert (output.end (), selected[index].begin (), selected[index].end ());
+        output.push_back (0);
+    }
+
+    size_t original_total = 0;
+
+    for (size_t index = 0; index < selected.size (); ++index)
+    {
+        std::vector< byte > data;
+        std::vector< byte > compressed_data;
+
+        if (!read_file (folder + '/' + selected[index], data))
+        {
+            std::fprintf (stderr, "error: can't read %s\n", selected[index].c_str ());
+            return 1;
+        }
+
+        lz4_compress (data.data (), data.size (), compressed_data);
+
+        bool compress = compressed_data.size () <= data.size () - data.size () / 8;
+
+        const std::vector< byte > & payload = compress ? compressed_data : data;
+
+        pad (output, Asset_Pack::alignment);
+
+        Asset_Pack::Entry & entry = entries[index];
+
+        entry.offset      = uint32_t(output.size ());
+        entry.stored_size = uint32_t(payload.size ());
+        entry.size        = uint32_t(data.size ());
+        entry.compression = compress ? Asset_Pack::LZ4 : Asset_Pack::STORED;
+
+        // El offset 0 marca los huecos libres, así que ninguna entrada puede empezar ahí (la
+        // cabecera lo impide):
+
+        output.insert (output.end (), payload.begin (), payload.end ());
+
+        std::printf ("%-40s %8zu -> %8zu %s\n", selected[index].c_str (), data.size (), payload.size (), compress ? "lz4" : "stored");
+
+        original_total += data.size ();
+    }
+
+    for (auto & entry : entries)
+    {
+        uint32_t index = entry.id & (slot_count - 1);
+
+        while (slots[index].offset != 0) index = (index + 1) & (slot_count - 1);
+
+        slots[index] = entry;
+    }
+
+    Asset_Pack::Header header{ Asset_Pack::magic, Asset_Pack::version, uint32_t(selected.size ()), slot_count };
+
+    std::memcpy (output.data (), &header, sizeof(header));
+    std::memcpy (output.data () + sizeof(header), slots.data (), slots.size () * sizeof(Asset_Pack::Entry));
+
+    std::ofstream writer(output_path, std::ios::binary);
+
+    writer.write (reinterpret_cast< const char * >(output.data ()), std::streamsize(output.size ()));
+
+    if (!writer.good ())
+    {
+        std::fprintf (stderr, "error: can't write %s\n", output_path.c_str ());
+        return 1;
+    }
+
+    std::printf ("%zu files, %zu -> %zu bytes\n", selected.size (), original_total, output.size ());
+
+    return 0;
+}
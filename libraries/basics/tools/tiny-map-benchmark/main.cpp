@@ -0,0 +1,132 @@
+/*
+ * TINY MAP BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181840
+ */
+
+// Mide, para cada tipo de mapa y cantidad de claves Id:
+//
+//   - build:  crear el mapa, insertar las claves y destruirlo (como las propiedades de un Event).
+//   - lookup: buscar claves que están en el mapa en orden aleatorio (como get_renderer() o las
+//             texturas de Game_Scene).
+//
+//     tiny-map-benchmark [iterations]
+
+#include <map>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <basics/Id>
+#include <basics/Tiny_Map>
+
+using namespace basics;
+
+namespace
+{
+
+    typedef std::chrono::steady_clock Clock;
+
+    struct Result
+    {
+        double build_ns;                            ///< Por mapa.
+        double lookup_ns;                           ///< Por búsqueda.
+    };
+
+    // find() de los mapas estándar apunta a un par y el de Tiny_Map retorna un iterador con value():
+
+    template< class MAP >
+    inline void * find_value (MAP & map, Id key)
+    {
+        return map.find (key)->second;
+    }
+
+    template< size_t CAPACITY >
+    inline void * find_value (Tiny_Map< Id, void *, CAPACITY > & map, Id key)
+    {
+        return map.find (key).value ();
+    }
+
+    template< class MAP >
+    Result run (const std::vector< Id > & keys, const std::vector< Id > & queries, size_t iterations)
+    {
+        Result    result;
+        uintptr_t checksum = 0;
+
+        Clock::time_point begin = Clock::now ();
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            MAP map;
+
+            for (auto key : keys) map[key] = reinterpret_cast< void * >(uintptr_t(key));
+
+            checksum += map.size ();
+        }
+
+        result.build_ns = std::chrono::duration< double, std::nano >(Clock::now () - begin).count () / iterations;
+
+        MAP map;
+
+        for (auto key : keys) map[key] = reinterpret_cast< void * >(uintptr_t(key));
+
+        begin = Clock::now ();
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (auto key : queries)
+            {
+                checksum += reinterpret_cast< uintptr_t >(find_value (map, key));
+            }
+        }
+
+        result.lookup_ns = std::chrono::duration< double, std::nano >(Clock::now () - begin).count () / (double(iterations) * queries.size ());
+
+        if (checksum == 1) std::printf ("?");
+
+        return result;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    size_t iterations = number_of_arguments > 1 ? std::strtoul (arguments[1], nullptr, 10) : 200000;
+
+    std::mt19937 random(1234);
+
+    // 1 clave: Graphics_Context::renderers, 3: propiedades de un Event (id, x, y),
+    // 22: Game_Scene::textures.
+
+    for (size_t key_count : { 1, 3, 8, 22, 64 })
+    {
+        std::vector< Id > keys;
+        std::vector< Id > queries;
+
+        for (size_t index = 0; index < key_count; ++index) keys.push_back (Id(random ()));
+
+        for (size_t index = 0; index < 64; ++index) queries.push_back (keys[random () % key_count]);
+
+        Result ordered   = run< std::map          < Id, void * > > (keys, queries, iterations);
+        Result unordered = run< std::unordered_map< Id, void * > > (keys, queries, iterations);
+        Result tiny      = run< Tiny_Map< Id, void *, 32 >         > (keys, queries, iterations);
+
+        std::printf
+        (
+            "%3zu keys | build ns: map %7.1f  unordered %7.1f  tiny %7.1f | lookup ns: map %5.2f  unordered %5.2f  tiny %5.2f\n",
+            key_count,
+            ordered.build_ns,  unordered.build_ns,  tiny.build_ns,
+            ordered.lookup_ns, unordered.lookup_ns, tiny.lookup_ns
+        );
+    }
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * TOUCH PREDICTOR REPLAY
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181870
+ */
+
+// Reproduce una traza de toques y mide cuánto se aleja la posición prevista por Touch_Predictor de
+// la posición real, comparándolo con no predecir (usar la última muestra):
+//
+//     touch-predictor-replay [trace.csv | -] [window-ms]
+//
+// Cada línea de la traza es "time_ns,pointer_id,action,x,y" con action igual a down, move o up
+// (los datos de los eventos touch-started, touch-moved y touch-ended, incluido su historial). Sin
+// traza (o con -) se genera una sintética: trazos curvos muestreados a 120 Hz con algo de ruido.
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <random>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <basics/Touch_Predictor>
+
+using namespace basics;
+
+namespace
+{
+
+    struct Trace_Sample
+    {
+        int64_t time;
+        int32_t pointer_id;
+        char    action;                             ///< 'd', 'm' o 'u'.
+        float   x;
+        float   y;
+    };
+
+    typedef std::vector< Trace_Sample > Trace;
+
+    bool load_trace (const std::string & path, Trace & trace)
+    {
+        std::ifstream reader(path);
+
+        if (!reader) return false;
+
+        std::string line;
+
+        while (std::getline (reader, line))
+        {
+            std::replace (line.begin (), line.end (), ',', ' ');
+
+            std::istringstream fields(line);
+            Trace_Sample       sample;
+            std::string        action;
+
+            if (fields >> sample.time >> sample.pointer_id >> action >> sample.x >> sample.y)
+            {
+                sample.action = action[0];
+
+                trace.push_back (sample);
+            }
+        }
+
+        return !trace.empty ();
+    }
+
+    Trace make_synthetic_trace ()
+    {
+        std::mt19937                      random(1234);
+        std::uniform_real_distribution< > uniform(0.0, 1.0);
+        std::normal_distribution< >       noise(0.0, 0.7);
+
+        Trace   trace;
+        int64_t time = 0;
+
+        for (unsigned stroke = 0; stroke < 200; ++stroke)
+        {
+            // Trazo con aceleración y curvatura variables, de 150 a 600 ms:
+
+            double duration = 0.15 + 0.45 * uniform (random);
+            double radius   = 100.0 + 400.0 * uniform (random);
+            double turn     = (uniform (random) - 0.5) * 4.0;
+            double angle    = uniform (random) * 6.28318;
+            double cx       = 640.0, cy = 360.0;
+            size_t count    = size_t(duration * 120.0);
+
+            for (size_t index = 0; index <= count; ++index)
+            {
+                double s = double(index) / count;
+                double e = s * s * (3.0 - 2.0 * s);                     // Arranca y frena suavemente.
+                double a = angle + turn * e;
+                double r = radius * e;
+
+                trace.push_back
+                ({
+                    time,
+                    0,
+                    index == 0 ? 'd' : index == count ? 'u' : 'm',
+                    float(cx + r * std::cos (a) + noise (random)),
+                    float(cy + r * std::sin (a) + noise (random))
+                });
+
+                time += 8333333;
+            }
+
+            time += 300000000;
+        }
+
+        return trace;
+    }
+
+    /**
+     * Posición real del puntero en el instante indicado interpolando entre las muestras que siguen
+     * a la de first. Retorna false si el trazo termina antes.
+     */
+    bool get_actual_position (const Trace & trace, size_t first, int64_t time, float & x, float & y)
+    {
+        int32_t pointer_id = trace[first].pointer_id;
+        size_t  previous   = first;
+
+        for (size_t index = first + 1; index < trace.size (); ++index)
+        {
+            const Trace_Sample & sample = trace[index];
+
+            if (sample.pointer_id != pointer_id) continue;
+
+            if (sample.time >= time)
+            {
+                const Trace_Sample & before = trace[previous];
+
+                float t = float(time - before.time) / float(std::max< int64_t > (1, sample.time - before.time));
+
+                x = before.x + (sample.x - before.x) * t;
+                y = before.y + (sample.y - before.y) * t;
+
+                return true;
+            }
+
+            if (sample.action != 'm') return false;
+
+            previous = index;
+        }
+
+        return false;
+    }
+
+    struct Error_Stats
+    {
+        std::vector< float > errors;
+
+        void add (float dx, float dy)
+        {
+            errors.push_back (std::sqrt (dx * dx + dy * dy));
+        }
+
+        void print (const char * label)
+        {
+            if (errors.empty ()) return;
+
+            std::sort (errors.begin (), errors.end ());
+
+            double sum = 0, sum_squares = 0;
+
+            for (float error : errors) { sum += error; sum_squares += error * error; }
+
+            std::printf
+            (
+                "  %-10s mean %6.2f  rms %6.2f  p95 %6.2f  max %7.2f px\n",
+                label,
+                sum / errors.size (),
+                std::sqrt (sum_squares / errors.size ()),
+                errors[errors.size () * 95 / 100],
+                errors.back ()
+            );
+        }
+    };
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    Trace trace;
+
+    if (number_of_arguments > 1 && std::string(arguments[1]) != "-")
+    {
+        if (!load_trace (arguments[1], trace))
+        {
+            std::fprintf (stderr, "error: can't read %s\n", arguments[1]);
+            return 1;
+        }
+    }
+    else
+    {
+        trace = make_synthetic_trace ();
+    }
+
+    float window = number_of_arguments > 2 ? float(std::atof (arguments[2])) / 1000.f : .03f;
+
+    std::printf ("%zu samples, window %.0f ms\n", trace.size (), window * 1000.f);
+
+    for (float horizon_ms : { 8.f, 16.f, 25.f, 33.f })
+    {
+        int64_t         horizon = int64_t(horizon_ms * 1e6f);
+        Touch_Predictor predictor(horizon_ms / 1000.f);
+        Error_Stats     predicted;
+        Error_Stats     last;
+
+        predictor.set_window (window);
+
+        for (size_t index = 0; index < trace.size (); ++index)
+        {
+            const Trace_Sample & sample = trace[index];
+
+            if (sample.action == 'u')
+            {
+                predictor.remove (sample.pointer_id);
+                continue;
+            }
+
+            if (sample.action == 'd')
+            {
+                predictor.remove (sample.pointer_id);
+            }
+
+            predictor.add_sample (sample.pointer_id, { sample.x, sample.y, sample.time });
+
+            float actual_x, actual_y;
+
+            if (get_actual_position (trace, index, sample.time + horizon, actual_x, actual_y))
+            {
+                Touch_Predictor::Sample prediction;
+
+                predictor.predict (sample.pointer_id, sample.time + horizon, prediction);
+
+                predicted.add (prediction.x - actual_x, prediction.y - actual_y);
+                last     .add (sample.x     - actual_x, sample.y     - actual_y);
+            }
+        }
+
+        std::printf ("horizon %.0f ms:\n", horizon_ms);
+
+        last     .print ("last");
+        predicted.print ("predicted");
+    }
+
+    return 0;
+}